@@ -0,0 +1,92 @@
+#include <JuceHeader.h>
+#include <Mach1Encode.h>
+
+#include <iostream>
+
+#include "CoefficientTable.h"
+
+// Builds the coefficient table for every tabulated input and output mode and compares it against the
+// exact encoder output. The probe positions come from a fixed seed, so the error columns of two runs
+// with the same resolution and sdk are identical, only the timings depend on the machine.
+//
+// usage: M1-Panner-CoefficientTableBenchmark [--resolution 72x19x11] [--probes 4096] [--max-error 0.01]
+// Exits with 1 if any table's largest error is above --max-error.
+
+namespace
+{
+struct NamedMode
+{
+    int mode;
+    const char* name;
+};
+
+// every input mode of at most MixingEngine::maxInputChannels channels, stereo is never tabulated
+constexpr NamedMode inputModes[] = {
+    { Mach1EncodeInputMode::Mono, "Mono" },
+    { Mach1EncodeInputMode::LCR, "LCR" },
+    { Mach1EncodeInputMode::Quad, "Quad" },
+    { Mach1EncodeInputMode::LCRS, "LCRS" },
+    { Mach1EncodeInputMode::AFormat, "AFormat" },
+    { Mach1EncodeInputMode::BFOAACN, "1OA ACN" },
+    { Mach1EncodeInputMode::BFOAFUMA, "1OA FuMa" },
+    { Mach1EncodeInputMode::FiveDotZero, "5.0" },
+    { Mach1EncodeInputMode::FiveDotOneFilm, "5.1 Film" },
+    { Mach1EncodeInputMode::FiveDotOneDTS, "5.1 DTS" },
+    { Mach1EncodeInputMode::FiveDotOneSMTPE, "5.1 SMPTE" }
+};
+
+constexpr NamedMode outputModes[] = {
+    { Mach1EncodeOutputMode::M1Spatial_4, "M1Spatial-4" },
+    { Mach1EncodeOutputMode::M1Spatial_8, "M1Spatial-8" },
+    { Mach1EncodeOutputMode::M1Spatial_14, "M1Spatial-14" }
+};
+
+juce::String getOption(const juce::StringArray& arguments, const juce::String& name, const juce::String& fallback)
+{
+    const int index = arguments.indexOf(name);
+    return index >= 0 && index + 1 < arguments.size() ? arguments[index + 1] : fallback;
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    juce::StringArray arguments;
+    for (int argument = 1; argument < argc; argument++)
+        arguments.add(argv[argument]);
+
+    const auto resolutionText = getOption(arguments, "--resolution", CoefficientTable::Resolution().toString());
+    const auto resolution = CoefficientTable::Resolution::fromString(resolutionText);
+    if (resolution.toString() != resolutionText.trim().toLowerCase())
+    {
+        std::cerr << "invalid resolution " << resolutionText << ", at most " << CoefficientTable::Resolution::maxGridPoints << " grid points of at least "
+                  << CoefficientTable::Resolution::minSteps << " steps per axis" << std::endl;
+        return 2;
+    }
+    const int numProbes = juce::jmax(1, getOption(arguments, "--probes", "4096").getIntValue());
+    const float maxError = getOption(arguments, "--max-error", "1").getFloatValue();
+
+    std::cout << "resolution " << resolution.toString() << ", " << numProbes << " probes" << std::endl;
+
+    Mach1Encode<float> encoder;
+    CoefficientTable table;
+    bool withinLimit = true;
+    for (const auto& output : outputModes)
+    {
+        for (const auto& input : inputModes)
+        {
+            CoefficientTable::Key key;
+            key.inputMode = input.mode;
+            key.outputMode = output.mode;
+            key.pannerMode = Mach1EncodePannerMode::IsotropicLinear;
+            key.gainCompensation = true;
+
+            table.build(encoder, key, resolution);
+            const auto report = table.measureAccuracy(encoder, numProbes);
+            withinLimit = withinLimit && report.maxAbsoluteError <= maxError;
+
+            std::cout << juce::String(input.name).paddedRight(' ', 10) << " -> " << juce::String(output.name).paddedRight(' ', 13)
+                      << report.toString() << std::endl;
+        }
+    }
+    return withinLimit ? 0 : 1;
+}
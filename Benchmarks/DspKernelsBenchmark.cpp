@@ -0,0 +1,95 @@
+#include <JuceHeader.h>
+
+#include <iostream>
+
+#include "DspKernels.h"
+
+// Checks every DSP kernel variant the running CPU supports against the scalar generic build and times
+// the steady mix and the fractional delay read of each. The check runs on data from a fixed seed.
+//
+// usage: M1-Panner-DspKernelsBenchmark [--iterations 2000] [--max-deviation 0.0001]
+// Exits with 1 if any variant deviates from the generic build by more than --max-deviation.
+
+namespace
+{
+constexpr int blockSize = 512;
+constexpr int maxInputs = DspKernelSet::numSteadyInputCounts;
+constexpr int maxOutputs = 14;
+
+juce::String getOption(const juce::StringArray& arguments, const juce::String& name, const juce::String& fallback)
+{
+    const int index = arguments.indexOf(name);
+    return index >= 0 && index + 1 < arguments.size() ? arguments[index + 1] : fallback;
+}
+
+/// Microseconds per call of `function`
+template <typename Function>
+double timePerCall(int iterations, Function&& function)
+{
+    function(); // warm up
+    const auto startTicks = juce::Time::getHighResolutionTicks();
+    for (int iteration = 0; iteration < iterations; iteration++)
+        function();
+    return juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks) * 1.0e6 / iterations;
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    juce::StringArray arguments;
+    for (int argument = 1; argument < argc; argument++)
+        arguments.add(argv[argument]);
+
+    const int iterations = juce::jmax(1, getOption(arguments, "--iterations", "2000").getIntValue());
+    const float maxDeviation = getOption(arguments, "--max-deviation", "0.0001").getFloatValue();
+
+    juce::Random random(0x4d31);
+    std::vector<float> inputData((size_t)maxInputs * blockSize), outputData((size_t)maxOutputs * blockSize), gains((size_t)maxInputs * maxOutputs);
+    for (auto& sample : inputData)
+        sample = random.nextFloat() * 2.0f - 1.0f;
+    for (auto& gain : gains)
+        gain = random.nextFloat();
+
+    std::array<const float*, maxInputs> inputs {};
+    for (int input_channel = 0; input_channel < maxInputs; input_channel++)
+        inputs[(size_t)input_channel] = inputData.data() + input_channel * blockSize;
+    std::array<float*, maxOutputs> outputs {};
+    for (int output_channel = 0; output_channel < maxOutputs; output_channel++)
+        outputs[(size_t)output_channel] = outputData.data() + output_channel * blockSize;
+
+    // a ring of 4096 samples plus the copy of its first taps behind it, read back at a drifting delay
+    std::vector<float> ring(4096 + DspKernelSet::fractionalDelayTaps);
+    for (auto& sample : ring)
+        sample = random.nextFloat() * 2.0f - 1.0f;
+    std::vector<float> interpolated(blockSize);
+
+    std::cout << "block of " << blockSize << " samples, microseconds per block" << std::endl;
+
+    bool withinLimit = true;
+    for (auto isa : { DspIsa::generic, DspIsa::sse2, DspIsa::neon, DspIsa::avx2, DspIsa::avx512 })
+    {
+        const auto* kernels = DspKernels::getVariant(isa);
+        if (kernels == nullptr)
+        {
+            std::cout << juce::String(DspKernels::getName(isa)).paddedRight(' ', 8) << "not available" << std::endl;
+            continue;
+        }
+
+        const float deviation = DspKernels::measureDeviation(*kernels);
+        withinLimit = withinLimit && deviation <= maxDeviation;
+
+        std::array<DspLevel, maxOutputs> levels {};
+        const double monoTo8 = timePerCall(iterations, [&] { kernels->steady[0][1](inputs.data(), outputs.data(), gains.data(), maxOutputs, 0, blockSize, levels.data()); });
+        const double stereoTo14 = timePerCall(iterations, [&] { kernels->steady[1][2](inputs.data(), outputs.data(), gains.data(), maxOutputs, 0, blockSize, levels.data()); });
+        const double fiveOneTo14 = timePerCall(iterations, [&] { kernels->steady[5][2](inputs.data(), outputs.data(), gains.data(), maxOutputs, 0, blockSize, levels.data()); });
+        const double fractionalRead = timePerCall(iterations, [&] { kernels->readFractional(interpolated.data(), ring.data(), 4095, gains.data(), 4, 1000.25, 0.9973, blockSize); });
+
+        std::cout << juce::String(DspKernels::getName(isa)).paddedRight(' ', 8)
+                  << "deviation: " << juce::String(deviation, 8)
+                  << " | mono -> 8: " << juce::String(monoTo8, 3)
+                  << " | stereo -> 14: " << juce::String(stereoTo14, 3)
+                  << " | 5.1 -> 14: " << juce::String(fiveOneTo14, 3)
+                  << " | fractional read: " << juce::String(fractionalRead, 3) << std::endl;
+    }
+    return withinLimit ? 0 : 1;
+}
@@ -0,0 +1,350 @@
+#!/usr/bin/env python3
+"""Minimal stand-in for the m1-system-helper to exercise the panner's helper link.
+
+Registers panners over UDP, accepts the shared memory transport they offer, pings them and
+prints the round trip of every ping along with the telemetry they stream.
+"""
+
+import argparse
+import ctypes
+import math
+import mmap
+import platform
+import select
+import socket
+import struct
+import sys
+import time
+
+# /m1-ping capability bits, see PannerOSCHub::helperCapabilityPannerDelta
+CAPABILITY_PANNER_DELTA = 1
+
+# SharedMemoryRing layout, see Source/SharedMemoryRing.h
+RING_MAGIC = 0x4D315242
+RING_VERSION = 2
+RING_HEADER_SIZE = 192
+RING_WRITE_POSITION = 64
+RING_DOORBELL = 68
+RING_READ_POSITION = 128
+RING_CONSUMER_WAITING = 132
+RING_WRAP_MARKER = 0xFFFFFFFF
+
+
+class Doorbell:
+    """The futex (Linux) or __ulock (macOS) wait and wake on a ring's doorbell word, a short sleep elsewhere"""
+
+    FUTEX_SYSCALLS = {"x86_64": 202, "aarch64": 98, "arm64": 98}
+
+    def __init__(self):
+        self.libc = None
+        self.futex = None
+        if sys.platform.startswith("linux") and platform.machine() in self.FUTEX_SYSCALLS:
+            self.libc = ctypes.CDLL(None, use_errno=True)
+            self.futex = self.FUTEX_SYSCALLS[platform.machine()]
+        elif sys.platform == "darwin":
+            self.libc = ctypes.CDLL(None, use_errno=True)
+
+    def wait(self, word, value, timeout):
+        if self.futex is not None:
+            seconds = int(timeout)
+            timespec = (ctypes.c_long * 2)(seconds, int((timeout - seconds) * 1e9))
+            self.libc.syscall(self.futex, ctypes.byref(word), 0, ctypes.c_uint32(value), ctypes.byref(timespec), None, 0)  # FUTEX_WAIT
+        elif self.libc is not None:
+            self.libc.__ulock_wait(3, ctypes.byref(word), ctypes.c_uint64(value), ctypes.c_uint32(int(timeout * 1e6)))  # UL_COMPARE_AND_WAIT_SHARED
+        elif word.value == value:
+            time.sleep(min(timeout, 0.001))
+
+    def wake(self, word):
+        if self.futex is not None:
+            self.libc.syscall(self.futex, ctypes.byref(word), 1, 0x7FFFFFFF, None, None, 0)  # FUTEX_WAKE
+        elif self.libc is not None:
+            self.libc.__ulock_wake(3 | 0x100, ctypes.byref(word), ctypes.c_uint64(0))  # ULF_WAKE_ALL
+
+
+DOORBELL = Doorbell()
+
+
+def pad4(data):
+    return data + b"\0" * ((4 - len(data) % 4) % 4)
+
+
+def encode_string(text):
+    return pad4(text.encode("utf-8") + b"\0")
+
+
+def encode_message(address, *args):
+    tags = ","
+    payload = b""
+    for arg in args:
+        if isinstance(arg, bool) or isinstance(arg, int):
+            tags += "i"
+            payload += struct.pack(">i", int(arg))
+        elif isinstance(arg, float):
+            tags += "f"
+            payload += struct.pack(">f", arg)
+        elif isinstance(arg, str):
+            tags += "s"
+            payload += encode_string(arg)
+        elif isinstance(arg, bytes):
+            tags += "b"
+            payload += struct.pack(">i", len(arg)) + pad4(arg)
+        else:
+            raise TypeError(f"unsupported OSC argument {arg!r}")
+    return encode_string(address) + encode_string(tags) + payload
+
+
+def read_string(data, offset):
+    end = data.index(b"\0", offset)
+    return data[offset:end].decode("utf-8"), (end + 4) & ~3
+
+
+def decode_packet(data):
+    """Returns the (address, args) of every message in a message or bundle"""
+    if data.startswith(b"#bundle\0"):
+        messages = []
+        offset = 16  # "#bundle" and the time tag
+        while offset + 4 <= len(data):
+            (size,) = struct.unpack_from(">i", data, offset)
+            messages += decode_packet(data[offset + 4:offset + 4 + size])
+            offset += 4 + size
+        return messages
+
+    address, offset = read_string(data, 0)
+    tags, offset = read_string(data, offset)
+    args = []
+    for tag in tags[1:]:
+        if tag == "i":
+            args.append(struct.unpack_from(">i", data, offset)[0])
+            offset += 4
+        elif tag == "f":
+            args.append(struct.unpack_from(">f", data, offset)[0])
+            offset += 4
+        elif tag == "r":
+            args.append("#%08x" % struct.unpack_from(">I", data, offset)[0])
+            offset += 4
+        elif tag == "s":
+            text, offset = read_string(data, offset)
+            args.append(text)
+        elif tag == "b":
+            (size,) = struct.unpack_from(">i", data, offset)
+            args.append(data[offset + 4:offset + 4 + size])
+            offset += 4 + ((size + 3) & ~3)
+        else:
+            raise ValueError(f"unsupported OSC type tag {tag!r}")
+    return [(address, args)]
+
+
+class Ring:
+    """One side of a SharedMemoryRing created by the panner"""
+
+    def __init__(self, path):
+        self.file = open(path, "r+b")
+        self.memory = mmap.mmap(self.file.fileno(), 0)
+        magic, version, capacity, _ = struct.unpack_from("<4I", self.memory, 0)
+        if magic != RING_MAGIC or version != RING_VERSION:
+            raise ValueError(f"{path} is not a version {RING_VERSION} ring")
+        self.capacity = capacity
+        self.doorbell = ctypes.c_uint32.from_buffer(self.memory, RING_DOORBELL)
+
+    def close(self):
+        del self.doorbell  # the mapping can't close while ctypes points into it
+        self.memory.close()
+        self.file.close()
+
+    def _load(self, offset):
+        return struct.unpack_from("<I", self.memory, offset)[0]
+
+    def _store(self, offset, value):
+        struct.pack_into("<I", self.memory, offset, value & 0xFFFFFFFF)
+
+    def write(self, payload):
+        record_size = 4 + ((len(payload) + 3) & ~3)
+        position = self._load(RING_WRITE_POSITION)
+        free_space = self.capacity - ((position - self._load(RING_READ_POSITION)) & 0xFFFFFFFF)
+        offset = position & (self.capacity - 1)
+        tail_space = self.capacity - offset
+        skip = tail_space if record_size > tail_space else 0
+        if skip + record_size > free_space:
+            return False
+
+        if skip:
+            self._store(RING_HEADER_SIZE + offset, RING_WRAP_MARKER)
+            position += skip
+            offset = 0
+
+        start = RING_HEADER_SIZE + offset
+        self._store(start, len(payload))
+        self.memory[start + 4:start + 4 + len(payload)] = payload
+        self._store(RING_WRITE_POSITION, position + record_size)
+
+        # Python has no fence to order the store above before a load of the consumer's waiting
+        # flag, so unlike the panner the stand-in rings after every write
+        self._store(RING_DOORBELL, self._load(RING_DOORBELL) + 1)
+        DOORBELL.wake(self.doorbell)
+        return True
+
+    def wait(self, timeout):
+        """Sleeps until the panner rings the doorbell or `timeout` seconds passed"""
+        ticket = self._load(RING_DOORBELL)
+        self._store(RING_CONSUMER_WAITING, 1)
+        if self._load(RING_READ_POSITION) == self._load(RING_WRITE_POSITION):
+            DOORBELL.wait(self.doorbell, ticket, timeout)
+        self._store(RING_CONSUMER_WAITING, 0)
+
+    def read(self):
+        position = self._load(RING_READ_POSITION)
+        if position == self._load(RING_WRITE_POSITION):
+            return None
+
+        offset = position & (self.capacity - 1)
+        (size,) = struct.unpack_from("<I", self.memory, RING_HEADER_SIZE + offset)
+        if size == RING_WRAP_MARKER:
+            position += self.capacity - offset
+            self._store(RING_READ_POSITION, position)
+            return self.read()
+
+        start = RING_HEADER_SIZE + offset + 4
+        payload = bytes(self.memory[start:start + size])
+        self._store(RING_READ_POSITION, position + 4 + ((size + 3) & ~3))
+        return payload
+
+
+class Plugin:
+    def __init__(self, port):
+        self.port = port
+        self.from_plugin = None  # the panner's outbound ring
+        self.to_plugin = None
+        self.ping_sent = None
+        self.round_trips = []
+
+    def close_rings(self):
+        for ring in (self.from_plugin, self.to_plugin):
+            if ring:
+                ring.close()
+        self.from_plugin = self.to_plugin = None
+
+
+class StandinHelper:
+    def __init__(self, args):
+        self.args = args
+        self.socket = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+        self.socket.bind(("127.0.0.1", args.port))
+        self.plugins = {}
+        self.keyframed = set()  # panner IDs whose full /panner-settings arrived
+        self.last_ping = 0.0
+        self.last_monitor = 0.0
+        self.start_time = time.monotonic()
+
+    def send(self, plugin, address, *args):
+        packet = encode_message(address, *args)
+        if plugin.to_plugin and plugin.to_plugin.write(packet):
+            return
+        self.socket.sendto(packet, ("127.0.0.1", plugin.port))
+
+    def handle(self, address, args, path):
+        if address == "/panner-settings" and len(args) >= 2:
+            if args[1] == -1:
+                self.keyframed.discard(args[0])
+            else:
+                self.keyframed.add(args[0])
+        elif address == "/panner-delta" and args and args[0] not in self.keyframed:
+            # joined mid-stream, the panner behind one of the ports sends its full state
+            self.keyframed.add(args[0])
+            for plugin in self.plugins.values():
+                self.send(plugin, "/panner-keyframe-request", args[0])
+
+        if address == "/m1-register-plugin":
+            port = args[0]
+            if port not in self.plugins:
+                self.plugins[port] = Plugin(port)
+            print(f"registered panner port {port}")
+        elif address == "/m1-shm-offer":
+            port, version, outbound, inbound = args[:4]
+            plugin = self.plugins.get(port)
+            if plugin is None or self.args.no_shm or version != RING_VERSION:
+                print(f"ignoring shared memory offer of {port}")
+                return
+            plugin.close_rings()
+            plugin.from_plugin = Ring(outbound)
+            plugin.to_plugin = Ring(inbound)
+            self.send(plugin, "/m1-shm-accept", port)
+            print(f"shared memory transport with {port}: {outbound} / {inbound}")
+        elif address == "/m1-shm-close":
+            plugin = self.plugins.get(args[0])
+            if plugin:
+                plugin.close_rings()
+                print(f"panner {args[0]} closed the shared memory transport")
+        elif address == "/m1-status-plugin":
+            plugin = self.plugins.get(args[0])
+            if plugin and plugin.ping_sent is not None:
+                round_trip = (time.perf_counter() - plugin.ping_sent) * 1000.0
+                plugin.ping_sent = None
+                plugin.round_trips.append(round_trip)
+                print(f"ping {args[0]} via {path}: {round_trip:.3f} ms")
+        elif self.args.verbose or address not in ("/panner-settings", "/panner-delta"):
+            print(f"{path} {address} {args}")
+
+    def poll_rings(self):
+        for plugin in list(self.plugins.values()):
+            while plugin.from_plugin:
+                packet = plugin.from_plugin.read()
+                if packet is None:
+                    break
+                for address, args in decode_packet(packet):
+                    self.handle(address, args, "shm")
+
+    def tick(self):
+        now = time.monotonic()
+        if now - self.last_ping >= 1.0:
+            self.last_ping = now
+            capabilities = 0 if self.args.no_delta else CAPABILITY_PANNER_DELTA
+            for plugin in self.plugins.values():
+                plugin.ping_sent = time.perf_counter()
+                self.send(plugin, "/m1-ping", capabilities)
+
+        if self.args.monitor_rate > 0 and now - self.last_monitor >= 1.0 / self.args.monitor_rate:
+            self.last_monitor = now
+            yaw = math.degrees(math.sin(now - self.start_time)) * 2.0
+            # the send time in microseconds of the monotonic clock, as a wrapping int32
+            sent_us = (time.monotonic_ns() // 1000) & 0xFFFFFFFF
+            sent_us -= (sent_us & 0x80000000) << 1
+            for plugin in self.plugins.values():
+                self.send(plugin, "/monitor-settings", 0, float(yaw), 0.0, 0.0, sent_us)
+
+    def run(self):
+        print(f"stand-in helper listening on 127.0.0.1:{self.args.port}")
+        try:
+            while True:
+                # sleep on the doorbell of a ring if there is one, UDP is only checked in between
+                rings = [plugin.from_plugin for plugin in self.plugins.values() if plugin.from_plugin]
+                if rings:
+                    rings[0].wait(0.0005)
+                readable, _, _ = select.select([self.socket], [], [], 0.0 if rings else 0.0005)
+                if readable:
+                    packet, _ = self.socket.recvfrom(65536)
+                    for address, args in decode_packet(packet):
+                        self.handle(address, args, "udp")
+                self.poll_rings()
+                self.tick()
+        except KeyboardInterrupt:
+            pass
+        finally:
+            for plugin in self.plugins.values():
+                if plugin.round_trips:
+                    trips = sorted(plugin.round_trips)
+                    print(f"{plugin.port}: {len(trips)} pings, median {trips[len(trips) // 2]:.3f} ms")
+                plugin.close_rings()
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Stand-in m1-system-helper for testing the panner's helper link")
+    parser.add_argument("--port", type=int, default=9001, help="helperPort from settings.json (default: 9001)")
+    parser.add_argument("--no-shm", action="store_true", help="decline shared memory offers to test the UDP fallback")
+    parser.add_argument("--no-delta", action="store_true", help="don't advertise /panner-delta support, the panners send full /panner-settings")
+    parser.add_argument("--monitor-rate", type=float, default=0.0, help="send a sweeping /monitor-settings yaw at this rate in Hz")
+    parser.add_argument("--verbose", action="store_true", help="print every telemetry message")
+    StandinHelper(parser.parse_args()).run()
+
+
+if __name__ == "__main__":
+    main()
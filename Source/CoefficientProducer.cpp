@@ -0,0 +1,192 @@
+#include "CoefficientProducer.h"
+
+CoefficientWorker::CoefficientWorker()
+    : juce::Thread("M1-Panner Coefficients")
+{
+    startThread();
+    startTimer(wakeIntervalMs);
+}
+
+CoefficientWorker::~CoefficientWorker()
+{
+    stopTimer();
+    stopThread(1000);
+}
+
+void CoefficientWorker::add(CoefficientProducer* producer)
+{
+    const juce::ScopedLock sl(producersLock);
+    if (std::find(producers.begin(), producers.end(), producer) == producers.end())
+        producers.push_back(producer);
+}
+
+void CoefficientWorker::remove(CoefficientProducer* producer)
+{
+    const juce::ScopedLock sl(producersLock);
+    producers.erase(std::remove(producers.begin(), producers.end(), producer), producers.end());
+}
+
+void CoefficientWorker::wake() noexcept
+{
+    if (juce::MessageManager::existsAndIsCurrentThread())
+        notify();
+    else
+        wakeRequested.store(true);
+}
+
+void CoefficientWorker::timerCallback()
+{
+    if (wakeRequested.exchange(false))
+        notify();
+}
+
+void CoefficientWorker::run()
+{
+    while (!threadShouldExit())
+    {
+        bool producedAny = false;
+        {
+            // held while producing, remove() must not return while a producer calls back into its processor
+            const juce::ScopedLock sl(producersLock);
+            for (auto* producer : producers)
+                producedAny = producer->produceIfRequested() || producedAny;
+        }
+
+        // a wake-up that arrives while producing leaves the event signalled, nothing is lost
+        if (!producedAny)
+            wait(-1);
+    }
+}
+
+CoefficientProducer::CoefficientProducer(EncoderSetup encoderSetup)
+    : setup(std::move(encoderSetup))
+{
+}
+
+CoefficientProducer::~CoefficientProducer()
+{
+    stop();
+}
+
+void CoefficientProducer::start()
+{
+    if (!started.exchange(true))
+    {
+        worker->add(this);
+        worker->wake();
+    }
+}
+
+void CoefficientProducer::stop()
+{
+    if (started.exchange(false))
+        worker->remove(this);
+}
+
+void CoefficientProducer::requestUpdate() noexcept
+{
+    updateRequested.store(true);
+    if (started.load())
+        worker->wake();
+}
+
+void CoefficientProducer::enableTable(const CoefficientTable::Resolution& resolution)
+{
+    if (!resolution.isValid())
+    {
+        jassertfalse;
+        DBG("[LUT] Ignoring coefficient table resolution " + resolution.toString());
+        return;
+    }
+
+    tableResolution.update([&resolution](CoefficientTable::Resolution& published) { published = resolution; });
+    tableEnabled.store(true);
+    requestUpdate();
+}
+
+const CoefficientTable* CoefficientProducer::acquireTable() noexcept
+{
+    int index = publishedTable.load();
+    for (;;)
+    {
+        if (index < 0)
+            return nullptr;
+
+        tableInUse.store(index);
+        const int latest = publishedTable.load();
+        if (latest == index)
+            return &tables[(size_t)index];
+        index = latest;
+    }
+}
+
+bool CoefficientProducer::produceIfRequested()
+{
+    if (!updateRequested.exchange(false))
+        return false;
+
+    produce();
+    return true;
+}
+
+void CoefficientProducer::produce()
+{
+    CoefficientTable::Key key;
+    CoefficientFrame::InputTrims inputTrims;
+    inputTrims.fill(1.0f);
+    setup(encoder, key, inputTrims);
+
+    auto& frame = frames.getWriteBuffer();
+    const auto gains = encoder.getGains();
+
+    frame.numInputs = juce::jmin((int)gains.size(), MixingEngine::maxInputChannels);
+    frame.numOutputs = 0;
+    for (int input_channel = 0; input_channel < frame.numInputs; input_channel++)
+    {
+        const int numOutputs = juce::jmin((int)gains[input_channel].size(), MixingEngine::maxOutputChannels);
+        juce::FloatVectorOperations::copyWithMultiply(frame.gains.data() + input_channel * CoefficientFrame::rowStride, gains[input_channel].data(), inputTrims[(size_t)input_channel], numOutputs);
+        frame.numOutputs = input_channel == 0 ? numOutputs : juce::jmin(frame.numOutputs, numOutputs);
+
+        if (input_channel == 0)
+            juce::FloatVectorOperations::copy(frame.untrimmedFirstRow.data(), gains[0].data(), numOutputs);
+    }
+    frame.gainCompensationDb = encoder.getGainCompensation(true);
+    frame.inputTrims = inputTrims;
+    frame.generation = nextGeneration++;
+    frame.tableKey = key;
+
+    // Debug output for gain compensation changes
+    if (std::abs(lastGainCompensationDb - frame.gainCompensationDb) > 0.1f)
+    {
+        DBG("Gain compensation changed: " + juce::String(lastGainCompensationDb, 2) + " -> " + juce::String(frame.gainCompensationDb, 2) + " dB");
+    }
+    lastGainCompensationDb = frame.gainCompensationDb;
+
+    frames.publish();
+
+    if (tableEnabled.load())
+        rebuildTableIfNeeded(key);
+}
+
+void CoefficientProducer::rebuildTableIfNeeded(const CoefficientTable::Key& key)
+{
+    if (!CoefficientTable::supports(key))
+    {
+        // the audio thread mixes the frames generated by the encoder
+        publishedTable.store(-1);
+        return;
+    }
+
+    const auto resolution = tableResolution.read();
+    const int current = publishedTable.load();
+    if (current >= 0 && tables[(size_t)current].getKey() == key && tables[(size_t)current].getResolution() == resolution)
+        return;
+
+    // wait for the audio thread to let go of the slot we are about to overwrite
+    const int next = current == 0 ? 1 : 0;
+    while (tableInUse.load() == next && !worker->isExiting())
+        juce::Thread::sleep(1);
+
+    tables[(size_t)next].build(encoder, key, resolution);
+    publishedTable.store(next);
+}
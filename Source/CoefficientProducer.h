@@ -0,0 +1,132 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <Mach1Encode.h>
+
+#include "CoefficientTable.h"
+#include "MixingEngine.h"
+#include "SnapshotBuffer.h"
+#include "TripleBuffer.h"
+
+/// Full Mach1Encode result for one parameter snapshot, in M1 channel order
+struct CoefficientFrame
+{
+    static constexpr int rowStride = MixingEngine::maxOutputChannels;
+
+    /// Linear gain of every input row, e.g. the stereo input balance
+    using InputTrims = std::array<float, MixingEngine::maxInputChannels>;
+
+    int numInputs = 0;
+    int numOutputs = 0;
+    float gainCompensationDb = 0.0f;
+    juce::uint32 generation = 0;
+    CoefficientTable::Key tableKey; // non-positional settings the frame was produced with
+    InputTrims inputTrims {}; // already applied to `gains`
+    std::array<float, MixingEngine::maxInputChannels * MixingEngine::maxOutputChannels> gains {};
+    std::array<float, MixingEngine::maxOutputChannels> untrimmedFirstRow {}; // encoder gains of input 0 without its trim, for ITD
+
+    const float* getRow(int inputChannel) const noexcept { return gains.data() + inputChannel * rowStride; }
+};
+
+class CoefficientProducer;
+
+/// The one thread that runs the encoders of every CoefficientProducer in the process.
+///
+/// It sleeps until a producer asks for an update, so idle instances cost nothing. Requests made on the
+/// message thread wake it right away. Waking a thread locks a mutex, so requests from any other thread
+/// (the audio thread) only set a flag that a timer on the message thread turns into a wake-up within
+/// `wakeIntervalMs`.
+class CoefficientWorker : private juce::Thread,
+                          private juce::Timer
+{
+public:
+    static constexpr int wakeIntervalMs = 5;
+
+    CoefficientWorker();
+    ~CoefficientWorker() override;
+
+    void add(CoefficientProducer* producer);
+
+    /// Waits for the producer to finish if it is being serviced, it is never called again afterwards
+    void remove(CoefficientProducer* producer);
+
+    /// Any thread, realtime safe
+    void wake() noexcept;
+
+    bool isExiting() const { return threadShouldExit(); }
+
+private:
+    void run() override;
+    void timerCallback() override;
+
+    juce::CriticalSection producersLock;
+    std::vector<CoefficientProducer*> producers;
+    std::atomic<bool> wakeRequested { false };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CoefficientWorker)
+};
+
+/// Runs `Mach1Encode::generatePointResults()` on the shared CoefficientWorker thread and publishes the
+/// resulting gain matrix through a wait-free triple buffer, so the audio thread only ever picks up
+/// finished frames at the start of a block no matter how dense the parameter automation is.
+class CoefficientProducer
+{
+public:
+    /// Applies a snapshot of the current parameters to the encoder, generates its points, fills in the
+    /// non-positional settings used to key the optional coefficient table and the per-input trims
+    /// (preset to unity) that are folded into the published matrix
+    using EncoderSetup = std::function<void(Mach1Encode<float>&, CoefficientTable::Key&, CoefficientFrame::InputTrims&)>;
+
+    explicit CoefficientProducer(EncoderSetup encoderSetup);
+    ~CoefficientProducer();
+
+    /// Attaches to the worker thread
+    void start();
+
+    /// Detaches from the worker, waits for a frame in production to finish
+    void stop();
+
+    /// Marks the coefficients as stale and wakes the worker, realtime safe
+    void requestUpdate() noexcept;
+
+    /// Audio thread: swaps in the newest frame, returns false if nothing new was produced
+    bool acquireLatest() noexcept { return frames.acquireLatest(); }
+
+    /// Audio thread: the frame picked up by the last successful acquireLatest()
+    const CoefficientFrame& getCurrentFrame() const noexcept { return frames.getReadBuffer(); }
+
+    /// Also keeps a CoefficientTable in sync with the non-positional settings of the latest frame. Can be
+    /// called again at any time to change the grid, the table is then rebuilt on the producer thread.
+    /// Not from the audio thread.
+    void enableTable(const CoefficientTable::Resolution& resolution);
+
+    /// Audio thread: the newest finished table or nullptr, must be paired with releaseTable()
+    const CoefficientTable* acquireTable() noexcept;
+    void releaseTable() noexcept { tableInUse.store(-1); }
+
+private:
+    friend class CoefficientWorker;
+
+    /// Worker thread: produces a frame if one was requested, returns whether it did
+    bool produceIfRequested();
+    void produce();
+    void rebuildTableIfNeeded(const CoefficientTable::Key& key);
+
+    juce::SharedResourcePointer<CoefficientWorker> worker;
+    std::atomic<bool> started { false };
+    EncoderSetup setup;
+    Mach1Encode<float> encoder;
+    TripleBuffer<CoefficientFrame> frames;
+    std::atomic<bool> updateRequested { false };
+    juce::uint32 nextGeneration = 1;
+    float lastGainCompensationDb = 0.0f;
+
+    // Two table slots, the audio thread announces the slot it reads so the producer never rebuilds it
+    std::atomic<bool> tableEnabled { false };
+    SnapshotBuffer<CoefficientTable::Resolution> tableResolution;
+    std::array<CoefficientTable, 2> tables;
+    std::atomic<int> publishedTable { -1 };
+    std::atomic<int> tableInUse { -1 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CoefficientProducer)
+};
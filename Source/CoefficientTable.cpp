@@ -0,0 +1,218 @@
+#include "CoefficientTable.h"
+
+namespace
+{
+float gridAzimuth(int index, int steps)
+{
+    return -180.0f + 360.0f * (float)index / (float)steps;
+}
+
+float gridLinear(int index, int steps, float start, float end)
+{
+    return steps > 1 ? start + (end - start) * (float)index / (float)(steps - 1) : start;
+}
+
+/// Splits a value into the lower grid index and the fractional position towards the next one
+void locate(float position, int steps, int& index, float& fraction)
+{
+    position = juce::jlimit(0.0f, (float)(steps - 1), position);
+    index = juce::jmin((int)position, juce::jmax(0, steps - 2));
+    fraction = position - (float)index;
+}
+}
+
+bool CoefficientTable::Key::operator==(const Key& other) const noexcept
+{
+    return inputMode == other.inputMode
+        && outputMode == other.outputMode
+        && pannerMode == other.pannerMode
+        && autoOrbit == other.autoOrbit
+        && gainCompensation == other.gainCompensation;
+}
+
+bool CoefficientTable::Resolution::isValid() const noexcept
+{
+    return azimuthSteps >= minSteps && elevationSteps >= minSteps && divergeSteps >= minSteps
+        && (juce::int64)azimuthSteps * elevationSteps * divergeSteps <= maxGridPoints;
+}
+
+bool CoefficientTable::Resolution::operator==(const Resolution& other) const noexcept
+{
+    return azimuthSteps == other.azimuthSteps
+        && elevationSteps == other.elevationSteps
+        && divergeSteps == other.divergeSteps;
+}
+
+juce::String CoefficientTable::Resolution::toString() const
+{
+    return juce::String(azimuthSteps) + "x" + juce::String(elevationSteps) + "x" + juce::String(divergeSteps);
+}
+
+CoefficientTable::Resolution CoefficientTable::Resolution::fromString(const juce::String& text)
+{
+    const auto steps = juce::StringArray::fromTokens(text.trim().toLowerCase(), "x", {});
+    if (steps.size() != 3 || !steps[0].containsOnly("0123456789") || !steps[1].containsOnly("0123456789") || !steps[2].containsOnly("0123456789"))
+        return {};
+
+    Resolution parsed;
+    parsed.azimuthSteps = steps[0].getIntValue();
+    parsed.elevationSteps = steps[1].getIntValue();
+    parsed.divergeSteps = steps[2].getIntValue();
+    return parsed.isValid() ? parsed : Resolution();
+}
+
+juce::String CoefficientTable::ErrorReport::toString() const
+{
+    return "probes: " + juce::String(numProbes)
+        + " | max error: " + juce::String(maxAbsoluteError, 6)
+        + " | rms error: " + juce::String(rmsError, 6)
+        + " | build: " + juce::String(buildMilliseconds, 1) + " ms"
+        + " | exact: " + juce::String(exactMicrosecondsPerCall, 3) + " us/call"
+        + " | lookup: " + juce::String(lookupMicrosecondsPerCall, 3) + " us/call";
+}
+
+void CoefficientTable::configureEncoder(Mach1Encode<float>& encoder, const Key& tableKey)
+{
+    encoder.setInputMode(static_cast<Mach1EncodeInputMode>(tableKey.inputMode));
+    encoder.setOutputMode(static_cast<Mach1EncodeOutputMode>(tableKey.outputMode));
+    encoder.setPannerMode(static_cast<Mach1EncodePannerMode>(tableKey.pannerMode));
+    encoder.setAutoOrbit(tableKey.autoOrbit);
+    encoder.setGainCompensationActive(tableKey.gainCompensation);
+    encoder.setOutputGain(0.0f, true); // unity, the input gain is applied on lookup
+}
+
+void CoefficientTable::build(Mach1Encode<float>& encoder, const Key& newKey, const Resolution& newResolution)
+{
+    const auto startTicks = juce::Time::getHighResolutionTicks();
+
+    jassert(supports(newKey) && newResolution.isValid());
+    key = newKey;
+    resolution = newResolution.isValid() ? newResolution : Resolution();
+
+    configureEncoder(encoder, key);
+    numInputs = juce::jmin(encoder.getInputChannelsCount(), MixingEngine::maxInputChannels);
+    numOutputs = juce::jmin(encoder.getOutputChannelsCount(), MixingEngine::maxOutputChannels);
+    numPairs = numInputs * numOutputs;
+    table.assign((size_t)resolution.azimuthSteps * (size_t)resolution.elevationSteps * (size_t)resolution.divergeSteps * (size_t)numPairs, 0.0f);
+
+    for (int a = 0; a < resolution.azimuthSteps; a++)
+    {
+        encoder.setAzimuthDegrees(gridAzimuth(a, resolution.azimuthSteps));
+        for (int e = 0; e < resolution.elevationSteps; e++)
+        {
+            encoder.setElevationDegrees(gridLinear(e, resolution.elevationSteps, -90.0f, 90.0f));
+            for (int d = 0; d < resolution.divergeSteps; d++)
+            {
+                encoder.setDiverge(gridLinear(d, resolution.divergeSteps, -1.0f, 1.0f));
+                encoder.generatePointResults();
+
+                const auto gains = encoder.getGains();
+                float* point = getGridPoint(a, e, d);
+                for (int input_channel = 0; input_channel < juce::jmin(numInputs, (int)gains.size()); input_channel++)
+                {
+                    for (int output_channel = 0; output_channel < juce::jmin(numOutputs, (int)gains[input_channel].size()); output_channel++)
+                    {
+                        point[input_channel * numOutputs + output_channel] = gains[input_channel][output_channel];
+                    }
+                }
+            }
+        }
+    }
+
+    lastBuildMilliseconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks) * 1000.0;
+}
+
+void CoefficientTable::lookup(float azimuthDegrees, float elevationDegrees, float divergeNormalised, float gain, float* destination, int destinationRowStride) const noexcept
+{
+    if (numPairs == 0)
+        return;
+
+    // azimuth wraps, the last cell interpolates back to -180
+    float azimuthPosition = (azimuthDegrees + 180.0f) / 360.0f * (float)resolution.azimuthSteps;
+    azimuthPosition -= std::floor(azimuthPosition / (float)resolution.azimuthSteps) * (float)resolution.azimuthSteps;
+    const int a0 = juce::jlimit(0, resolution.azimuthSteps - 1, (int)azimuthPosition);
+    const int a1 = (a0 + 1) % resolution.azimuthSteps;
+    const float fa = juce::jlimit(0.0f, 1.0f, azimuthPosition - (float)a0);
+
+    int e0, d0;
+    float fe, fd;
+    locate((elevationDegrees + 90.0f) / 180.0f * (float)(resolution.elevationSteps - 1), resolution.elevationSteps, e0, fe);
+    locate((divergeNormalised + 1.0f) / 2.0f * (float)(resolution.divergeSteps - 1), resolution.divergeSteps, d0, fd);
+
+    const float* corners[8] = {
+        getGridPoint(a0, e0, d0), getGridPoint(a0, e0, d0 + 1),
+        getGridPoint(a0, e0 + 1, d0), getGridPoint(a0, e0 + 1, d0 + 1),
+        getGridPoint(a1, e0, d0), getGridPoint(a1, e0, d0 + 1),
+        getGridPoint(a1, e0 + 1, d0), getGridPoint(a1, e0 + 1, d0 + 1)
+    };
+    const float weights[8] = {
+        (1.0f - fa) * (1.0f - fe) * (1.0f - fd), (1.0f - fa) * (1.0f - fe) * fd,
+        (1.0f - fa) * fe * (1.0f - fd), (1.0f - fa) * fe * fd,
+        fa * (1.0f - fe) * (1.0f - fd), fa * (1.0f - fe) * fd,
+        fa * fe * (1.0f - fd), fa * fe * fd
+    };
+
+    for (int input_channel = 0; input_channel < numInputs; input_channel++)
+    {
+        float* row = destination + input_channel * destinationRowStride;
+        const int offset = input_channel * numOutputs;
+        for (int output_channel = 0; output_channel < numOutputs; output_channel++)
+        {
+            float value = 0.0f;
+            for (int corner = 0; corner < 8; corner++)
+            {
+                value += weights[corner] * corners[corner][offset + output_channel];
+            }
+            row[output_channel] = value * gain;
+        }
+    }
+}
+
+CoefficientTable::ErrorReport CoefficientTable::measureAccuracy(Mach1Encode<float>& encoder, int numProbes) const
+{
+    ErrorReport report;
+    report.buildMilliseconds = lastBuildMilliseconds;
+    if (numPairs == 0 || numProbes <= 0)
+        return report;
+
+    configureEncoder(encoder, key);
+    juce::Random random(0x4d31);
+    std::vector<float> interpolated((size_t)numInputs * (size_t)MixingEngine::maxOutputChannels);
+    double squaredErrorSum = 0.0;
+    juce::int64 exactTicks = 0, lookupTicks = 0;
+
+    for (int probe = 0; probe < numProbes; probe++)
+    {
+        const float azimuth = random.nextFloat() * 360.0f - 180.0f;
+        const float elevation = random.nextFloat() * 180.0f - 90.0f;
+        const float diverge = random.nextFloat() * 2.0f - 1.0f;
+
+        auto ticks = juce::Time::getHighResolutionTicks();
+        encoder.setAzimuthDegrees(azimuth);
+        encoder.setElevationDegrees(elevation);
+        encoder.setDiverge(diverge);
+        encoder.generatePointResults();
+        const auto exact = encoder.getGains();
+        exactTicks += juce::Time::getHighResolutionTicks() - ticks;
+
+        ticks = juce::Time::getHighResolutionTicks();
+        lookup(azimuth, elevation, diverge, 1.0f, interpolated.data(), MixingEngine::maxOutputChannels);
+        lookupTicks += juce::Time::getHighResolutionTicks() - ticks;
+
+        for (int input_channel = 0; input_channel < juce::jmin(numInputs, (int)exact.size()); input_channel++)
+        {
+            for (int output_channel = 0; output_channel < juce::jmin(numOutputs, (int)exact[input_channel].size()); output_channel++)
+            {
+                const float error = std::abs(exact[input_channel][output_channel] - interpolated[(size_t)(input_channel * MixingEngine::maxOutputChannels + output_channel)]);
+                report.maxAbsoluteError = juce::jmax(report.maxAbsoluteError, error);
+                squaredErrorSum += (double)error * (double)error;
+            }
+        }
+    }
+
+    report.numProbes = numProbes;
+    report.rmsError = (float)std::sqrt(squaredErrorSum / ((double)numProbes * (double)numPairs));
+    report.exactMicrosecondsPerCall = juce::Time::highResolutionTicksToSeconds(exactTicks) * 1.0e6 / numProbes;
+    report.lookupMicrosecondsPerCall = juce::Time::highResolutionTicksToSeconds(lookupTicks) * 1.0e6 / numProbes;
+    return report;
+}
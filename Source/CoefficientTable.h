@@ -0,0 +1,103 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <Mach1Encode.h>
+
+#include <vector>
+
+#include "MixingEngine.h"
+
+/// Precomputed Mach1Encode gain matrices over an azimuth x elevation x diverge grid.
+///
+/// A table is valid for one combination of the non-positional encoder settings (`Key`), it is built
+/// with unity output gain so the input gain parameter can be applied as a scalar on lookup. Stereo
+/// input is not tabulated, its gains also follow the continuous orbit azimuth and spread parameters
+/// and are always generated by the encoder directly (see `supports()`).
+/// `lookup()` trilinearly interpolates the eight surrounding grid points and never calls into
+/// Mach1Encode, which makes it cheap enough to evaluate at control rate on the audio thread.
+class CoefficientTable
+{
+public:
+    struct Key
+    {
+        int inputMode = -1;
+        int outputMode = -1;
+        int pannerMode = -1;
+        bool autoOrbit = false;
+        bool gainCompensation = false;
+
+        bool operator==(const Key& other) const noexcept;
+        bool operator!=(const Key& other) const noexcept { return !(*this == other); }
+    };
+
+    struct Resolution
+    {
+        static constexpr int minSteps = 2;
+        static constexpr int maxGridPoints = 65536; // a 14 channel table of 4 inputs takes 14 MB at this size
+
+        int azimuthSteps = 72; // 5 degrees, wraps around
+        int elevationSteps = 19; // 10 degrees, -90 and 90 inclusive
+        int divergeSteps = 11; // 0.2 diverge, -1 and 1 inclusive
+
+        bool isValid() const noexcept;
+        bool operator==(const Resolution& other) const noexcept;
+        bool operator!=(const Resolution& other) const noexcept { return !(*this == other); }
+
+        /// "72x19x11" style, azimuth x elevation x diverge steps
+        juce::String toString() const;
+
+        /// Parses toString() output, returns the default grid for anything that isn't a valid resolution
+        static Resolution fromString(const juce::String& text);
+    };
+
+    /// Accuracy and speed of the table against exact `Mach1Encode::getGains()` results
+    struct ErrorReport
+    {
+        int numProbes = 0;
+        float maxAbsoluteError = 0.0f;
+        float rmsError = 0.0f;
+        double buildMilliseconds = 0.0;
+        double exactMicrosecondsPerCall = 0.0;
+        double lookupMicrosecondsPerCall = 0.0;
+
+        juce::String toString() const;
+    };
+
+    /// False for settings a table can't represent, their frames have to come from the encoder
+    static bool supports(const Key& key) noexcept { return key.inputMode != Mach1EncodeInputMode::Stereo; }
+
+    /// Fills the grid by running the encoder at every grid point, call from a background thread
+    void build(Mach1Encode<float>& encoder, const Key& key, const Resolution& resolution);
+
+    /// Compares `numProbes` random positions against the exact encoder output
+    ErrorReport measureAccuracy(Mach1Encode<float>& encoder, int numProbes) const;
+
+    bool isReady() const noexcept { return numPairs > 0; }
+    const Key& getKey() const noexcept { return key; }
+    const Resolution& getResolution() const noexcept { return resolution; }
+    int getNumInputChannels() const noexcept { return numInputs; }
+    int getNumOutputChannels() const noexcept { return numOutputs; }
+
+    /// Writes the interpolated gain matrix scaled by `gain` to `destination`, one row of
+    /// `destinationRowStride` floats per input channel. Realtime safe.
+    void lookup(float azimuthDegrees, float elevationDegrees, float divergeNormalised, float gain, float* destination, int destinationRowStride) const noexcept;
+
+    /// Applies the non-positional settings of `key` to an encoder
+    static void configureEncoder(Mach1Encode<float>& encoder, const Key& key);
+
+private:
+    size_t getGridOffset(int azimuthIndex, int elevationIndex, int divergeIndex) const noexcept
+    {
+        return (size_t)((azimuthIndex * resolution.elevationSteps + elevationIndex) * resolution.divergeSteps + divergeIndex) * (size_t)numPairs;
+    }
+    const float* getGridPoint(int azimuthIndex, int elevationIndex, int divergeIndex) const noexcept { return table.data() + getGridOffset(azimuthIndex, elevationIndex, divergeIndex); }
+    float* getGridPoint(int azimuthIndex, int elevationIndex, int divergeIndex) noexcept { return table.data() + getGridOffset(azimuthIndex, elevationIndex, divergeIndex); }
+
+    Key key;
+    Resolution resolution;
+    int numInputs = 0;
+    int numOutputs = 0;
+    int numPairs = 0;
+    double lastBuildMilliseconds = 0.0;
+    std::vector<float> table;
+};
@@ -75,6 +75,10 @@
     #pragma message "ITD_PARAMETERS Active"
 #endif
 
+#ifdef COEFFICIENT_LUT
+    #pragma message "COEFFICIENT_LUT Active"
+#endif
+
 // ---
 
 /// Static Color Scheme
@@ -0,0 +1,184 @@
+#include <JuceHeader.h>
+
+#include "DspKernels.h"
+
+// The baseline build of the kernels, compiled with the project's default options. This is SSE2 on
+// x86-64 and NEON on arm64, both of which are part of the base instruction set of those platforms.
+namespace DspKernelsBaseline
+{
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define M1_DSP_ISA DspIsa::sse2
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+    #define M1_DSP_ISA DspIsa::neon
+#else
+    #define M1_DSP_ISA DspIsa::generic
+#endif
+#define M1_DSP_LANES 8
+#include "DspKernelsImpl.h"
+#undef M1_DSP_ISA
+#undef M1_DSP_LANES
+} // namespace DspKernelsBaseline
+
+namespace DspKernelsGeneric
+{
+const DspKernelSet* getKernelSet() noexcept;
+}
+
+namespace DspKernelsAvx2
+{
+const DspKernelSet* getKernelSet() noexcept;
+}
+
+namespace DspKernelsAvx512
+{
+const DspKernelSet* getKernelSet() noexcept;
+}
+
+namespace
+{
+std::atomic<const DspKernelSet*> selectedKernels { &DspKernelsBaseline::kernelSet };
+
+constexpr DspIsa allIsas[] = { DspIsa::generic, DspIsa::sse2, DspIsa::avx2, DspIsa::avx512, DspIsa::neon };
+} // namespace
+
+const DspKernelSet& DspKernels::get() noexcept
+{
+    return *selectedKernels.load(std::memory_order_acquire);
+}
+
+const DspKernelSet* DspKernels::getVariant(DspIsa isa) noexcept
+{
+    const auto* baseline = &DspKernelsBaseline::kernelSet;
+    switch (isa)
+    {
+        case DspIsa::generic:
+            return DspKernelsGeneric::getKernelSet();
+        case DspIsa::sse2:
+        case DspIsa::neon:
+            return baseline->isa == isa ? baseline : nullptr;
+        case DspIsa::avx2:
+            return juce::SystemStats::hasAVX2() && juce::SystemStats::hasFMA3() ? DspKernelsAvx2::getKernelSet() : nullptr;
+        case DspIsa::avx512:
+            return juce::SystemStats::hasAVX512F() && juce::SystemStats::hasAVX512VL() ? DspKernelsAvx512::getKernelSet() : nullptr;
+    }
+    return nullptr;
+}
+
+const char* DspKernels::getName(DspIsa isa) noexcept
+{
+    switch (isa)
+    {
+        case DspIsa::generic: return "generic";
+        case DspIsa::sse2: return "sse2";
+        case DspIsa::avx2: return "avx2";
+        case DspIsa::avx512: return "avx512";
+        case DspIsa::neon: return "neon";
+    }
+    return "unknown";
+}
+
+void DspKernels::selectForThisMachine()
+{
+    static const bool selected = []
+    {
+        const DspKernelSet* best = nullptr;
+        for (auto isa : { DspIsa::avx512, DspIsa::avx2 })
+        {
+            if (best == nullptr)
+                best = getVariant(isa);
+        }
+        if (best == nullptr)
+            best = &DspKernelsBaseline::kernelSet;
+
+        const auto forced = juce::SystemStats::getEnvironmentVariable("M1_FORCE_ISA", {}).trim().toLowerCase();
+        if (forced.isNotEmpty())
+        {
+            const DspKernelSet* forcedVariant = nullptr;
+            for (auto isa : allIsas)
+            {
+                if (forced == getName(isa))
+                    forcedVariant = getVariant(isa);
+            }
+
+            if (forcedVariant != nullptr)
+                best = forcedVariant;
+            else
+                DBG("[DSP] M1_FORCE_ISA=" + forced + " is not available on this machine");
+        }
+
+        selectedKernels.store(best, std::memory_order_release);
+        DBG("[DSP] Using " + juce::String(getName(best->isa)) + " kernels");
+        return true;
+    }();
+    juce::ignoreUnused(selected);
+}
+
+float DspKernels::measureDeviation(const DspKernelSet& variant)
+{
+    constexpr int numSamples = 509; // odd on purpose, covers the scalar tails
+    constexpr int maxInputs = DspKernelSet::numSteadyInputCounts;
+    constexpr int maxOutputs = 14;
+
+    juce::Random random(0x4d31);
+    std::vector<float> inputData((size_t)maxInputs * numSamples), gains((size_t)maxInputs * maxOutputs);
+    for (auto& sample : inputData)
+        sample = random.nextFloat() * 2.0f - 1.0f;
+    for (auto& gain : gains)
+        gain = random.nextFloat();
+
+    std::array<const float*, maxInputs> inputs {};
+    for (int input_channel = 0; input_channel < maxInputs; input_channel++)
+        inputs[(size_t)input_channel] = inputData.data() + input_channel * numSamples;
+
+    // runs every kernel of a variant and collects everything it produced in one vector
+    auto runAll = [&](const DspKernelSet& kernels)
+    {
+        std::vector<float> results;
+        std::vector<float> scratch((size_t)maxOutputs * numSamples);
+        std::array<float*, maxOutputs> outputs {};
+        for (int output_channel = 0; output_channel < maxOutputs; output_channel++)
+            outputs[(size_t)output_channel] = scratch.data() + output_channel * numSamples;
+
+        DspLevel level;
+        std::fill(scratch.begin(), scratch.end(), 0.0f);
+        kernels.addWithLinearRamp(outputs[0], inputs[0], 0.25f, 0.001f, numSamples);
+        kernels.addWithMultiplyAndMeasure(outputs[0], inputs[1], 0.5f, numSamples, level);
+        kernels.measure(inputs[2], numSamples, level);
+        results.insert(results.end(), outputs[0], outputs[0] + numSamples);
+        results.push_back(level.sumOfSquares);
+        results.push_back(level.peak);
+        results.push_back(kernels.dotProduct(inputs[3], inputs[4], numSamples));
+
+        // any data will do as ring and table here, it only has to be the same for every variant
+        std::vector<float> interpolated(numSamples);
+        kernels.readFractional(interpolated.data(), inputs[5], 255, gains.data(), 4, 300.25, 0.9973, numSamples);
+        results.insert(results.end(), interpolated.begin(), interpolated.end());
+
+        for (int inputs_index = 0; inputs_index < DspKernelSet::numSteadyInputCounts; inputs_index++)
+        {
+            for (int outputs_index = 0; outputs_index < DspKernelSet::numSteadyOutputCounts; outputs_index++)
+            {
+                std::array<DspLevel, maxOutputs> levels {};
+                std::fill(scratch.begin(), scratch.end(), 0.0f);
+                kernels.steady[inputs_index][outputs_index](inputs.data(), outputs.data(), gains.data(), maxOutputs, 0, numSamples, levels.data());
+                for (int output_channel = 0; output_channel < DspKernelSet::steadyOutputCounts[outputs_index]; output_channel++)
+                {
+                    results.insert(results.end(), outputs[(size_t)output_channel], outputs[(size_t)output_channel] + numSamples);
+                    results.push_back(levels[(size_t)output_channel].sumOfSquares);
+                    results.push_back(levels[(size_t)output_channel].peak);
+                }
+            }
+        }
+        return results;
+    };
+
+    const auto reference = runAll(*DspKernelsGeneric::getKernelSet());
+    const auto results = runAll(variant);
+    float largestDeviation = 0.0f;
+    for (size_t i = 0; i < reference.size(); i++)
+    {
+        const float deviation = std::abs(results[i] - reference[i]) / juce::jmax(1.0f, std::abs(reference[i]));
+        largestDeviation = juce::jmax(largestDeviation, deviation);
+    }
+    return largestDeviation;
+}
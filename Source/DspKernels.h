@@ -0,0 +1,77 @@
+#pragma once
+
+/// Instruction set specific builds of the inner DSP loops (mixing, ramping, metering and the
+/// fractional delay interpolation used by the ITD delay lines).
+///
+/// Every variant is compiled from the same source in DspKernelsImpl.h, the dispatcher picks the best
+/// one the running CPU supports once per process. `generic` is a scalar build without
+/// auto-vectorisation that serves as the reference for the others. Set the environment variable
+/// `M1_FORCE_ISA` to `generic`, `sse2`, `avx2`, `avx512` or `neon` to force a variant for benchmarking,
+/// the M1-Panner-DspKernelsBenchmark target checks and times every variant.
+/// This header deliberately does not include JUCE, it is shared with the translation units that are
+/// compiled for wider instruction sets.
+enum class DspIsa
+{
+    generic,
+    sse2,
+    avx2,
+    avx512,
+    neon
+};
+
+/// Sums over the samples written to one output
+struct DspLevel
+{
+    float sumOfSquares = 0.0f;
+    float peak = 0.0f;
+};
+
+struct DspKernelSet
+{
+    /// Steady state mix of a complete matrix, see MixingKernels
+    using SteadyKernel = void (*)(const float* const* inputs, float* const* outputs, const float* gains, int rowStride, int startSample, int numSamples, DspLevel* levels);
+
+    static constexpr int numSteadyInputCounts = 6; // 1 to 6 inputs
+    static constexpr int numSteadyOutputCounts = 3; // M1Spatial_4, M1Spatial_8, M1Spatial_14
+    static constexpr int steadyOutputCounts[numSteadyOutputCounts] = { 4, 8, 14 };
+
+    static constexpr int fractionalDelayTaps = 16;
+
+    DspIsa isa;
+
+    /// destination[i] += source[i] * (startGain + gainStep * (i + 1))
+    void (*addWithLinearRamp)(float* destination, const float* source, float startGain, float gainStep, int numSamples);
+
+    /// destination[i] += source[i] * gain, accumulating the level of the result
+    void (*addWithMultiplyAndMeasure)(float* destination, const float* source, float gain, int numSamples, DspLevel& level);
+
+    void (*measure)(const float* samples, int numSamples, DspLevel& level);
+
+    float (*dotProduct)(const float* a, const float* b, int numSamples);
+
+    /// Interpolates `numSamples` reads from a ring of `mask + 1` samples followed by a copy of its first
+    /// `fractionalDelayTaps` samples. Read i is centred on `startPosition + positionStep * i`, the taps
+    /// come from a polyphase table of `numPhases + 1` rows of `fractionalDelayTaps` coefficients.
+    void (*readFractional)(float* destination, const float* ring, int mask, const float* phaseTable, int numPhases, double startPosition, double positionStep, int numSamples);
+
+    SteadyKernel steady[numSteadyInputCounts][numSteadyOutputCounts];
+};
+
+namespace DspKernels
+{
+/// The currently selected variant, the baseline build until selectForThisMachine() has run
+const DspKernelSet& get() noexcept;
+
+/// Picks the best variant for the running CPU or the one forced through `M1_FORCE_ISA`,
+/// only does work on the first call, call from a non-realtime thread
+void selectForThisMachine();
+
+/// The variant for `isa` if it was compiled in and the running CPU supports it, otherwise nullptr
+const DspKernelSet* getVariant(DspIsa isa) noexcept;
+
+const char* getName(DspIsa isa) noexcept;
+
+/// Runs `variant` and the generic build on the same random data, returns the largest relative
+/// deviation between their results
+float measureDeviation(const DspKernelSet& variant);
+} // namespace DspKernels
@@ -0,0 +1,7 @@
+// AVX2 + FMA build of the kernels in DspKernelsImpl.h, only ever called after DspKernels has checked the CPU.
+
+#define M1_DSP_NAMESPACE DspKernelsAvx2
+#define M1_DSP_ISA DspIsa::avx2
+#define M1_DSP_LANES 8
+#define M1_DSP_TARGET "avx2,fma"
+#include "DspKernelsVariant.h"
@@ -0,0 +1,7 @@
+// AVX-512 (F + VL) build of the kernels in DspKernelsImpl.h, only ever called after DspKernels has checked the CPU.
+
+#define M1_DSP_NAMESPACE DspKernelsAvx512
+#define M1_DSP_ISA DspIsa::avx512
+#define M1_DSP_LANES 16
+#define M1_DSP_TARGET "avx512f,avx512vl,avx2,fma"
+#include "DspKernelsVariant.h"
@@ -0,0 +1,7 @@
+// Scalar build of the kernels in DspKernelsImpl.h, the reference every other variant is checked
+// against. CMakeLists.txt turns off auto-vectorisation for this file.
+
+#define M1_DSP_NAMESPACE DspKernelsGeneric
+#define M1_DSP_ISA DspIsa::generic
+#define M1_DSP_LANES 1
+#include "DspKernelsVariant.h"
@@ -0,0 +1,223 @@
+// No include guard: this file is included once per instruction set variant by the DspKernels
+// translation units, each time inside its own namespace and with its own target options.
+// It must not include anything, every header has to be included before the target options change.
+//
+// Expects M1_DSP_ISA (a DspIsa value) and M1_DSP_LANES (floats per vector register) to be defined.
+
+namespace
+{
+constexpr int lanes = M1_DSP_LANES;
+
+inline float maximum(float a, float b)
+{
+    return a > b ? a : b;
+}
+
+void addWithLinearRamp(float* destination, const float* source, float startGain, float gainStep, int numSamples)
+{
+    // the gain is derived from the sample index rather than accumulated, which leaves no loop carried
+    // dependency and lets the compiler vectorise this like any other multiply-accumulate
+    for (int sample = 0; sample < numSamples; sample++)
+    {
+        destination[sample] += source[sample] * (startGain + gainStep * (float)(sample + 1));
+    }
+}
+
+// The reductions below keep one partial sum per lane so they vectorise without -ffast-math
+
+void addWithMultiplyAndMeasure(float* destination, const float* source, float gain, int numSamples, DspLevel& level)
+{
+    float sumOfSquares[lanes] {}, peak[lanes] {};
+    int sample = 0;
+    for (; sample + lanes <= numSamples; sample += lanes)
+    {
+        for (int lane = 0; lane < lanes; lane++)
+        {
+            const float value = destination[sample + lane] + source[sample + lane] * gain;
+            destination[sample + lane] = value;
+            sumOfSquares[lane] += value * value;
+            peak[lane] = maximum(peak[lane], std::abs(value));
+        }
+    }
+    for (; sample < numSamples; sample++)
+    {
+        const float value = destination[sample] + source[sample] * gain;
+        destination[sample] = value;
+        sumOfSquares[0] += value * value;
+        peak[0] = maximum(peak[0], std::abs(value));
+    }
+
+    for (int lane = 0; lane < lanes; lane++)
+    {
+        level.sumOfSquares += sumOfSquares[lane];
+        level.peak = maximum(level.peak, peak[lane]);
+    }
+}
+
+void measure(const float* samples, int numSamples, DspLevel& level)
+{
+    float sumOfSquares[lanes] {}, peak[lanes] {};
+    int sample = 0;
+    for (; sample + lanes <= numSamples; sample += lanes)
+    {
+        for (int lane = 0; lane < lanes; lane++)
+        {
+            sumOfSquares[lane] += samples[sample + lane] * samples[sample + lane];
+            peak[lane] = maximum(peak[lane], std::abs(samples[sample + lane]));
+        }
+    }
+    for (; sample < numSamples; sample++)
+    {
+        sumOfSquares[0] += samples[sample] * samples[sample];
+        peak[0] = maximum(peak[0], std::abs(samples[sample]));
+    }
+
+    for (int lane = 0; lane < lanes; lane++)
+    {
+        level.sumOfSquares += sumOfSquares[lane];
+        level.peak = maximum(level.peak, peak[lane]);
+    }
+}
+
+float dotProduct(const float* a, const float* b, int numSamples)
+{
+    float sum[lanes] {};
+    int sample = 0;
+    for (; sample + lanes <= numSamples; sample += lanes)
+    {
+        for (int lane = 0; lane < lanes; lane++)
+        {
+            sum[lane] += a[sample + lane] * b[sample + lane];
+        }
+    }
+    for (; sample < numSamples; sample++)
+    {
+        sum[0] += a[sample] * b[sample];
+    }
+
+    float total = 0.0f;
+    for (int lane = 0; lane < lanes; lane++)
+    {
+        total += sum[lane];
+    }
+    return total;
+}
+
+void readFractional(float* destination, const float* ring, int mask, const float* phaseTable, int numPhases, double startPosition, double positionStep, int numSamples)
+{
+    constexpr int taps = DspKernelSet::fractionalDelayTaps;
+    for (int sample = 0; sample < numSamples; sample++)
+    {
+        const double position = startPosition + positionStep * (double)sample;
+        const double whole = std::floor(position);
+        const float phase = (float)(position - whole) * (float)numPhases;
+        const int phaseIndex = (int)phase < numPhases ? (int)phase : numPhases - 1;
+        const float phaseFraction = phase - (float)phaseIndex;
+
+        // the window of taps around the read position is contiguous thanks to the copy behind the ring
+        const float* samples = ring + (((int)whole - (taps / 2 - 1)) & mask);
+        const float* lower = phaseTable + phaseIndex * taps;
+        const float* upper = lower + taps;
+
+        float products[taps];
+        for (int tap = 0; tap < taps; tap++)
+        {
+            products[tap] = samples[tap] * (lower[tap] + (upper[tap] - lower[tap]) * phaseFraction);
+        }
+        for (int width = taps / 2; width > 0; width /= 2)
+        {
+            for (int tap = 0; tap < width; tap++)
+            {
+                products[tap] += products[tap + width];
+            }
+        }
+        destination[sample] = products[0];
+    }
+}
+
+template <int NumInputs, int NumOutputs>
+void mixSteady(const float* const* inputs, float* const* outputs, const float* gains, int rowStride, int startSample, int numSamples, DspLevel* levels)
+{
+    // muted or missing inputs read from any present input with a gain of zero, which keeps the loop branch free
+    const float* fallback = nullptr;
+    for (int input_channel = 0; input_channel < NumInputs && fallback == nullptr; input_channel++)
+    {
+        fallback = inputs[input_channel];
+    }
+    if (fallback == nullptr)
+        return;
+
+    const float* sources[NumInputs];
+    float matrix[NumOutputs][NumInputs];
+    for (int input_channel = 0; input_channel < NumInputs; input_channel++)
+    {
+        sources[input_channel] = (inputs[input_channel] != nullptr ? inputs[input_channel] : fallback) + startSample;
+        for (int output_channel = 0; output_channel < NumOutputs; output_channel++)
+        {
+            matrix[output_channel][input_channel] = inputs[input_channel] != nullptr ? gains[input_channel * rowStride + output_channel] : 0.0f;
+        }
+    }
+
+    for (int output_channel = 0; output_channel < NumOutputs; output_channel++)
+    {
+        float* destination = outputs[output_channel];
+        if (destination == nullptr)
+            continue;
+
+        destination += startSample;
+        const float* gain = matrix[output_channel];
+
+        float sumOfSquares[lanes] {}, peak[lanes] {};
+        int sample = 0;
+        for (; sample + lanes <= numSamples; sample += lanes)
+        {
+            for (int lane = 0; lane < lanes; lane++)
+            {
+                float value = destination[sample + lane];
+                for (int input_channel = 0; input_channel < NumInputs; input_channel++)
+                {
+                    value += sources[input_channel][sample + lane] * gain[input_channel];
+                }
+                destination[sample + lane] = value;
+                sumOfSquares[lane] += value * value;
+                peak[lane] = maximum(peak[lane], std::abs(value));
+            }
+        }
+        for (; sample < numSamples; sample++)
+        {
+            float value = destination[sample];
+            for (int input_channel = 0; input_channel < NumInputs; input_channel++)
+            {
+                value += sources[input_channel][sample] * gain[input_channel];
+            }
+            destination[sample] = value;
+            sumOfSquares[0] += value * value;
+            peak[0] = maximum(peak[0], std::abs(value));
+        }
+
+        auto& level = levels[output_channel];
+        for (int lane = 0; lane < lanes; lane++)
+        {
+            level.sumOfSquares += sumOfSquares[lane];
+            level.peak = maximum(level.peak, peak[lane]);
+        }
+    }
+}
+
+const DspKernelSet kernelSet {
+    M1_DSP_ISA,
+    &addWithLinearRamp,
+    &addWithMultiplyAndMeasure,
+    &measure,
+    &dotProduct,
+    &readFractional,
+    {
+        { &mixSteady<1, 4>, &mixSteady<1, 8>, &mixSteady<1, 14> }, // Mono
+        { &mixSteady<2, 4>, &mixSteady<2, 8>, &mixSteady<2, 14> }, // Stereo
+        { &mixSteady<3, 4>, &mixSteady<3, 8>, &mixSteady<3, 14> }, // LCR
+        { &mixSteady<4, 4>, &mixSteady<4, 8>, &mixSteady<4, 14> }, // Quad, LCRS, AFormat, 1OA ACN/FuMa
+        { &mixSteady<5, 4>, &mixSteady<5, 8>, &mixSteady<5, 14> }, // 5.0
+        { &mixSteady<6, 4>, &mixSteady<6, 8>, &mixSteady<6, 14> } // 5.1 Film/DTS/SMPTE
+    }
+};
+} // namespace
@@ -0,0 +1,57 @@
+// No include guard: this is the body of every DspKernels<Variant>.cpp, which only defines the
+// following and includes this file.
+//
+//   M1_DSP_NAMESPACE  namespace of the variant, getKernelSet() is declared in DspKernels.cpp
+//   M1_DSP_ISA        DspIsa value
+//   M1_DSP_LANES      floats per vector register, 1 for the scalar build
+//   M1_DSP_TARGET     optional, the GCC/clang target options of the variant. Target options are applied
+//                     per function so this also works in universal and MSVC builds, where a variant that
+//                     needs them is simply left out and getKernelSet() returns nullptr.
+
+#include <cmath>
+
+#include "DspKernels.h"
+
+#if !defined(M1_DSP_TARGET) || ((defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__)))
+    #if defined(M1_DSP_TARGET)
+        // #pragma doesn't expand macros, _Pragma of a stringised argument does
+        #define M1_DSP_PRAGMA(...) _Pragma(#__VA_ARGS__)
+        #define M1_DSP_PUSH_TARGET(options) M1_DSP_PRAGMA(clang attribute push(__attribute__((target(options))), apply_to = function))
+        #define M1_DSP_GCC_TARGET(options) M1_DSP_PRAGMA(GCC target(options))
+        #if defined(__clang__)
+            M1_DSP_PUSH_TARGET(M1_DSP_TARGET)
+        #else
+            #pragma GCC push_options
+            M1_DSP_GCC_TARGET(M1_DSP_TARGET)
+        #endif
+    #endif
+
+namespace M1_DSP_NAMESPACE
+{
+    #include "DspKernelsImpl.h"
+} // namespace M1_DSP_NAMESPACE
+
+    #if defined(M1_DSP_TARGET)
+        #if defined(__clang__)
+            #pragma clang attribute pop
+        #else
+            #pragma GCC pop_options
+        #endif
+    #endif
+
+namespace M1_DSP_NAMESPACE
+{
+const DspKernelSet* getKernelSet() noexcept
+{
+    return &kernelSet;
+}
+} // namespace M1_DSP_NAMESPACE
+#else
+namespace M1_DSP_NAMESPACE
+{
+const DspKernelSet* getKernelSet() noexcept
+{
+    return nullptr;
+}
+} // namespace M1_DSP_NAMESPACE
+#endif
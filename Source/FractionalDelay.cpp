@@ -0,0 +1,125 @@
+#include "FractionalDelay.h"
+
+const float* FractionalDelay::getPhaseTable()
+{
+    // row p holds the taps for a read position p / numPhases of a sample past the tap at index numTaps / 2 - 1
+    static const std::vector<float> table = []
+    {
+        std::vector<float> rows((size_t)(numPhases + 1) * numTaps);
+        const double halfWidth = numTaps / 2;
+        const double cutoff = 1.0; // full band, row 0 is a unit impulse so whole sample delays are exact
+
+        for (int phase = 0; phase <= numPhases; phase++)
+        {
+            float* row = rows.data() + (size_t)phase * numTaps;
+            double sum = 0.0;
+            for (int tap = 0; tap < numTaps; tap++)
+            {
+                const double x = (double)(tap - (numTaps / 2 - 1)) - (double)phase / numPhases;
+                const double sinc = x == 0.0 ? 1.0 : std::sin(juce::MathConstants<double>::pi * cutoff * x) / (juce::MathConstants<double>::pi * cutoff * x);
+                const double window = std::abs(x) >= halfWidth ? 0.0 : 0.42 + 0.5 * std::cos(juce::MathConstants<double>::pi * x / halfWidth) + 0.08 * std::cos(2.0 * juce::MathConstants<double>::pi * x / halfWidth);
+                row[tap] = (float)(sinc * window);
+                sum += row[tap];
+            }
+
+            // unity gain at DC for every phase
+            for (int tap = 0; tap < numTaps; tap++)
+            {
+                row[tap] = (float)(row[tap] / sum);
+            }
+        }
+        return rows;
+    }();
+    return table.data();
+}
+
+void FractionalDelay::prepare(int newNumChannels, int maxDelayInSamples, int maxBlockSize)
+{
+    phaseTable = getPhaseTable();
+
+    numChannels = juce::jmax(0, newNumChannels);
+    maxDelay = juce::jmax((int)minimumDelay, maxDelayInSamples);
+    ringSize = juce::nextPowerOfTwo(maxDelay + numTaps + juce::jmax(1, maxBlockSize));
+    mask = ringSize - 1;
+    channelStride = ringSize + numTaps;
+    writePosition = 0;
+
+    memory.calloc((size_t)numChannels * (size_t)channelStride);
+}
+
+void FractionalDelay::release()
+{
+    memory.free();
+    numChannels = 0;
+    maxDelay = 0;
+    ringSize = 0;
+    mask = 0;
+    channelStride = 0;
+    writePosition = 0;
+}
+
+void FractionalDelay::clear() noexcept
+{
+    if (memory != nullptr)
+        juce::FloatVectorOperations::clear(memory.get(), numChannels * channelStride);
+}
+
+void FractionalDelay::pushSample(int channel, float sample) noexcept
+{
+    float* ring = getChannel(channel);
+    ring[writePosition] = sample;
+    if (writePosition < numTaps)
+        ring[ringSize + writePosition] = sample;
+}
+
+void FractionalDelay::pushBlock(int channel, const float* samples, int numSamples) noexcept
+{
+    float* ring = getChannel(channel);
+    int position = writePosition;
+    while (numSamples > 0)
+    {
+        const int length = juce::jmin(numSamples, ringSize - position);
+        juce::FloatVectorOperations::copy(ring + position, samples, length);
+
+        // keep the copy of the start of the ring behind its end up to date
+        if (position < numTaps)
+            juce::FloatVectorOperations::copy(ring + ringSize + position, samples, juce::jmin(length, numTaps - position));
+
+        samples += length;
+        numSamples -= length;
+        position = (position + length) & mask;
+    }
+}
+
+float FractionalDelay::readSample(int channel, float delayInSamples) const noexcept
+{
+    float result = 0.0f;
+    DspKernels::get().readFractional(&result, getChannel(channel), mask, phaseTable, numPhases, (double)writePosition - clampDelay(delayInSamples), 0.0, 1);
+    return result;
+}
+
+void FractionalDelay::readBlock(int channel, float* destination, int numSamples, int delayInSamples) const noexcept
+{
+    const float* ring = getChannel(channel);
+    int position = (writePosition - juce::jlimit(0, maxDelay, delayInSamples)) & mask;
+    while (numSamples > 0)
+    {
+        const int length = juce::jmin(numSamples, ringSize - position);
+        juce::FloatVectorOperations::copy(destination, ring + position, length);
+        destination += length;
+        numSamples -= length;
+        position = (position + length) & mask;
+    }
+}
+
+void FractionalDelay::readBlock(int channel, float* destination, int numSamples, float startDelay, float endDelay) const noexcept
+{
+    if (numSamples <= 0)
+        return;
+
+    // read i sits at writePosition + i - (startDelay + delayStep * (i + 1)), which is linear in i
+    startDelay = clampDelay(startDelay);
+    endDelay = clampDelay(endDelay);
+    const double delayStep = ((double)endDelay - (double)startDelay) / numSamples;
+    DspKernels::get().readFractional(destination, getChannel(channel), mask, phaseTable, numPhases, (double)writePosition - startDelay - delayStep, 1.0 - delayStep, numSamples);
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "DspKernels.h"
+
+/// Multichannel delay line that is read at fractional, smoothly changing delays.
+///
+/// Reads use a windowed-sinc interpolator from a polyphase table (16 taps, 256 phases with linear
+/// interpolation between neighbouring phases) that is shared by every instance. Each channel is a
+/// power-of-two ring followed by a copy of its first 16 samples, so every read is a single masked,
+/// contiguous window and a whole block is interpolated with one call into the DspKernels variant
+/// for the running CPU.
+class FractionalDelay
+{
+public:
+    static constexpr int numTaps = DspKernelSet::fractionalDelayTaps;
+    static constexpr int numPhases = 256;
+
+    /// The interpolator needs this many samples after the read position, shorter delays are clamped
+    static constexpr int minimumDelay = numTaps / 2;
+
+    FractionalDelay() = default;
+
+    /// Allocates room for `maxDelayInSamples` plus interpolation and block headroom rounded up to a
+    /// power of two, call from a non-realtime thread
+    void prepare(int numChannels, int maxDelayInSamples, int maxBlockSize = 1);
+
+    /// Frees the delay memory, isPrepared() returns false afterwards
+    void release();
+
+    void clear() noexcept;
+
+    bool isPrepared() const noexcept { return numChannels > 0; }
+    int getNumChannels() const noexcept { return numChannels; }
+    int getMaximumDelay() const noexcept { return maxDelay; }
+
+    /// Size of the allocation in bytes
+    size_t getMemorySize() const noexcept { return (size_t)numChannels * (size_t)channelStride * sizeof(float); }
+
+    /// Writes one sample at the write position, use advance() once every channel has been written
+    void pushSample(int channel, float sample) noexcept;
+
+    /// Writes `numSamples` samples starting at the write position, use advance() once every channel has been written
+    void pushBlock(int channel, const float* samples, int numSamples) noexcept;
+
+    /// Reads `delayInSamples` behind the sample at the write position
+    float readSample(int channel, float delayInSamples) const noexcept;
+
+    /// Reads the block written by the last pushBlock() with the delay ramping linearly from
+    /// `startDelay` (before the first sample) to `endDelay` (at the last sample)
+    void readBlock(int channel, float* destination, int numSamples, float startDelay, float endDelay) const noexcept;
+
+    /// Same as above for a constant, whole sample delay, which needs no interpolation and no lookahead
+    void readBlock(int channel, float* destination, int numSamples, int delayInSamples) const noexcept;
+
+    void advance(int numSamples) noexcept { writePosition = (writePosition + numSamples) & mask; }
+
+private:
+    float* getChannel(int channel) const noexcept { return memory.get() + (size_t)channel * (size_t)channelStride; }
+    float clampDelay(float delayInSamples) const noexcept { return juce::jlimit((float)minimumDelay, (float)maxDelay, delayInSamples); }
+
+    static const float* getPhaseTable();
+
+    int numChannels = 0;
+    int maxDelay = 0;
+    int ringSize = 0;
+    int mask = 0;
+    int channelStride = 0;
+    int writePosition = 0;
+    juce::HeapBlock<float> memory;
+    const float* phaseTable = nullptr;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FractionalDelay)
+};
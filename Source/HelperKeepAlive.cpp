@@ -0,0 +1,19 @@
+#include "HelperKeepAlive.h"
+
+void HelperKeepAlive::heard(juce::uint32 nowMs) noexcept
+{
+    lastHeardTime = nowMs;
+    retryDelayMs = initialRetryDelayMs;
+}
+
+void HelperKeepAlive::attempted(juce::uint32 nowMs) noexcept
+{
+    lastAttemptTime = nowMs;
+    lastHeardTime = nowMs; // the helper gets a full window to answer
+}
+
+void HelperKeepAlive::failed(juce::uint32 nowMs) noexcept
+{
+    retryDelayMs = juce::jmin(maxRetryDelayMs, retryDelayMs * 2);
+    lastAttemptTime = nowMs;
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+/// Liveness and reconnect timing of the link to the m1-system-helper.
+///
+/// The helper counts as alive while anything was heard from it within the liveness window, a
+/// registration attempt opens a fresh window. Failed attempts and expired windows double the delay
+/// before the next attempt up to `maxRetryDelayMs`, hearing from the helper resets it.
+class HelperKeepAlive
+{
+public:
+    static constexpr juce::uint32 defaultLivenessWindowMs = 10000;
+    static constexpr juce::uint32 minLivenessWindowMs = 1000;
+    static constexpr juce::uint32 initialRetryDelayMs = 50;
+    static constexpr juce::uint32 maxRetryDelayMs = 5000;
+
+    void setLivenessWindow(juce::uint32 windowMs) noexcept { livenessWindowMs = juce::jmax(minLivenessWindowMs, windowMs); }
+    juce::uint32 getLivenessWindow() const noexcept { return livenessWindowMs; }
+
+    /// Anything arrived from the helper
+    void heard(juce::uint32 nowMs) noexcept;
+
+    /// A registration was sent
+    void attempted(juce::uint32 nowMs) noexcept;
+
+    /// A registration could not be sent or the helper went quiet
+    void failed(juce::uint32 nowMs) noexcept;
+
+    bool isAlive(juce::uint32 nowMs) const noexcept { return nowMs - lastHeardTime <= livenessWindowMs; }
+    bool isRetryDue(juce::uint32 nowMs) const noexcept { return nowMs - lastAttemptTime >= retryDelayMs; }
+    juce::uint32 getRetryDelay() const noexcept { return retryDelayMs; }
+
+private:
+    juce::uint32 livenessWindowMs = defaultLivenessWindowMs;
+    juce::uint32 retryDelayMs = initialRetryDelayMs;
+    juce::uint32 lastHeardTime = 0;
+    juce::uint32 lastAttemptTime = 0;
+};
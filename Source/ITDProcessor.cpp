@@ -0,0 +1,139 @@
+#include "ITDProcessor.h"
+
+#include "RealtimeGuard.h"
+
+void ITDProcessor::prepare(double newSampleRate, int maxBlockSize)
+{
+    const RealtimeGuard::ScopedLock sl(allocationLock);
+
+    release();
+    sampleRate = newSampleRate;
+    chunkSize = juce::jlimit(1, (int)maxChunkSize, maxBlockSize);
+}
+
+void ITDProcessor::allocate()
+{
+    const RealtimeGuard::ScopedLock sl(allocationLock);
+
+    if (allocated.load())
+        return;
+
+    // the largest delay the parameter can ask for plus the dry path latency, FractionalDelay adds the
+    // interpolator and chunk headroom and rounds the ring up to a power of two
+    const int maxDelayInSamples = (int)std::ceil(maxDelayMicroseconds * 1.0e-6 * sampleRate) + getLatencySamples();
+    delayLine.prepare(maxChannels, maxDelayInSamples, chunkSize);
+    wetScratch.calloc((size_t)chunkSize);
+    reset();
+
+    DBG("[ITD] Allocated " + juce::String((juce::int64)getMemorySize() / 1024) + " kB of delay memory at " + juce::String(sampleRate) + " Hz");
+    allocated.store(true, std::memory_order_release);
+}
+
+void ITDProcessor::release()
+{
+    const RealtimeGuard::ScopedLock sl(allocationLock);
+
+    allocated.store(false);
+    delayLine.release();
+    wetScratch.free();
+}
+
+void ITDProcessor::reset() noexcept
+{
+    delayLine.clear();
+    currentDelays.fill((float)getLatencySamples());
+    targetDelays.fill((float)getLatencySamples());
+    currentWet.fill(0.0f);
+    targetWet.fill(0.0f);
+}
+
+void ITDProcessor::setTargets(const float* gains, int numChannels, float delayTimeMicroseconds) noexcept
+{
+    const float delayTimeInSamples = juce::jlimit(0.0f, maxDelayMicroseconds, delayTimeMicroseconds) * (float)sampleRate * 1.0e-6f;
+    for (int channel = 0; channel < delayLine.getNumChannels(); channel++)
+    {
+        if (channel < numChannels)
+        {
+            // encoder gains above 0.25 get the full delay time, below that it scales linearly
+            const float amount = juce::jmin(0.25f, gains[channel]) * 4.0f;
+            targetDelays[(size_t)channel] = (float)getLatencySamples() + delayTimeInSamples * amount;
+        }
+        targetWet[(size_t)channel] = channel < numChannels ? 1.0f : 0.0f;
+    }
+}
+
+void ITDProcessor::setDryTargets() noexcept
+{
+    // the delays are left where they are so the delayed copy fades out unchanged
+    targetWet.fill(0.0f);
+}
+
+void ITDProcessor::process(float* const* channels, int numChannels, int numSamples) noexcept
+{
+    numChannels = juce::jmin(numChannels, delayLine.getNumChannels());
+
+    // large blocks are split into chunks, the delay ramp spans the whole block
+    for (int startSample = 0; startSample < numSamples; startSample += chunkSize)
+    {
+        const int length = juce::jmin(chunkSize, numSamples - startSample);
+        processChunk(channels, numChannels, startSample, length, (float)startSample / (float)numSamples, (float)(startSample + length) / (float)numSamples);
+    }
+
+    for (int channel = 0; channel < numChannels; channel++)
+    {
+        currentDelays[(size_t)channel] = targetDelays[(size_t)channel];
+        currentWet[(size_t)channel] = targetWet[(size_t)channel];
+    }
+}
+
+void ITDProcessor::processChunk(float* const* channels, int numChannels, int startSample, int numSamples, float startFraction, float endFraction) noexcept
+{
+    for (int channel = 0; channel < numChannels; channel++)
+    {
+        float* samples = channels[channel];
+        if (samples == nullptr)
+            continue;
+
+        samples += startSample;
+        const float blockStartDelay = currentDelays[(size_t)channel];
+        const float delayChange = targetDelays[(size_t)channel] - blockStartDelay;
+        const float chunkStartDelay = blockStartDelay + delayChange * startFraction;
+        const float chunkEndDelay = blockStartDelay + delayChange * endFraction;
+        const float blockStartWet = currentWet[(size_t)channel];
+        const float wetChange = targetWet[(size_t)channel] - blockStartWet;
+        const float chunkStartWet = blockStartWet + wetChange * startFraction;
+        const float chunkEndWet = blockStartWet + wetChange * endFraction;
+
+        delayLine.pushBlock(channel, samples, numSamples);
+        delayLine.readBlock(channel, samples, numSamples, getLatencySamples());
+
+        // the dry path alone needs no interpolated read
+        if (chunkStartWet == 0.0f && chunkEndWet == 0.0f)
+            continue;
+
+        delayLine.readBlock(channel, wetScratch.get(), numSamples, chunkStartDelay, chunkEndDelay);
+        blend(samples, wetScratch.get(), numSamples, chunkStartWet, chunkEndWet);
+    }
+    delayLine.advance(numSamples);
+}
+
+void ITDProcessor::blend(float* samples, const float* delayed, int numSamples, float startWet, float endWet) noexcept
+{
+    constexpr float panLaw = 0.707106781f;
+
+    // equal parts dry and delayed, pan-law applied via `panLaw`
+    if (startWet == 1.0f && endWet == 1.0f)
+    {
+        juce::FloatVectorOperations::add(samples, delayed, numSamples);
+        juce::FloatVectorOperations::multiply(samples, panLaw, numSamples);
+        return;
+    }
+
+    // crossfade between the dry path and the blend
+    const float wetStep = (endWet - startWet) / (float)numSamples;
+    for (int sample = 0; sample < numSamples; sample++)
+    {
+        const float wet = startWet + wetStep * (float)(sample + 1);
+        samples[sample] = samples[sample] * (1.0f - wet * (1.0f - panLaw)) + delayed[sample] * wet * panLaw;
+    }
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+#include <array>
+#include <atomic>
+
+#include "FractionalDelay.h"
+
+/// Post-mix interaural time difference stage.
+///
+/// Every output channel is blended with a copy of itself that is delayed in proportion to the channel's
+/// encoder gain, scaled by the DelayTime parameter. Delay targets are computed once per block and the
+/// delay ramps linearly across the block. The fractional read needs `FractionalDelay::minimumDelay`
+/// samples of lookahead, so the dry signal is delayed by the same amount and the stage reports that
+/// as its latency. Channels without a target only get that dry path delay, the blend fades in and out
+/// over one block whenever a channel switches between the two.
+///
+/// The delay memory is only allocated once ITD is switched on and is sized from the DelayTime range,
+/// a few kB per channel rather than seconds of audio.
+class ITDProcessor
+{
+public:
+    /// Upper end of the DelayTime parameter
+    static constexpr float maxDelayMicroseconds = 10000.0f;
+
+    /// M1Spatial_14, the widest Mach1Encode output
+    static constexpr int maxChannels = 14;
+
+    /// Blocks are processed in chunks of at most this many samples, which bounds the ring size
+    static constexpr int maxChunkSize = 256;
+
+    ITDProcessor() = default;
+
+    /// Records the stream format and frees memory allocated for a previous one, call from a non-realtime thread
+    void prepare(double sampleRate, int maxBlockSize);
+
+    /// Allocates the delay lines for the prepared format unless that already happened. Call from a
+    /// non-realtime thread, the audio thread skips the stage until isAllocated() turns true.
+    void allocate();
+
+    /// Frees the delay lines, the audio thread must not be inside process()
+    void release();
+
+    void reset() noexcept;
+
+    bool isAllocated() const noexcept { return allocated.load(std::memory_order_acquire); }
+
+    size_t getMemorySize() const noexcept { return delayLine.getMemorySize() + (size_t)chunkSize * sizeof(float); }
+
+    static constexpr int getLatencySamples() noexcept { return FractionalDelay::minimumDelay; }
+
+    /// Sets the delay of the first `numChannels` channels from `gains` (one encoder gain per channel,
+    /// M1 order) and the DelayTime parameter in microseconds, the channels after them only get the dry
+    /// path delay. Call once per block before process().
+    void setTargets(const float* gains, int numChannels, float delayTimeMicroseconds) noexcept;
+
+    /// Only the dry path delay for every channel, keeps the reported latency while ITD cannot be applied.
+    /// Call once per block before process().
+    void setDryTargets() noexcept;
+
+    /// Processes `channels` in place, nullptr channels are skipped
+    void process(float* const* channels, int numChannels, int numSamples) noexcept;
+
+private:
+    void processChunk(float* const* channels, int numChannels, int startSample, int numSamples, float startFraction, float endFraction) noexcept;
+    static void blend(float* samples, const float* delayed, int numSamples, float startWet, float endWet) noexcept;
+
+    juce::CriticalSection allocationLock; // never taken on the audio thread, RealtimeGuard counts it if it is
+    std::atomic<bool> allocated { false };
+    double sampleRate = 44100.0;
+    int chunkSize = maxChunkSize;
+    FractionalDelay delayLine;
+    juce::HeapBlock<float> wetScratch;
+    std::array<float, maxChannels> currentDelays {};
+    std::array<float, maxChannels> targetDelays {};
+    std::array<float, maxChannels> currentWet {}; // 1 blends in the delayed copy, 0 is the delayed dry signal only
+    std::array<float, maxChannels> targetWet {};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ITDProcessor)
+};
@@ -0,0 +1,58 @@
+#include "MeterEngine.h"
+
+void MeterEngine::prepare(double sampleRate) noexcept
+{
+    clipHoldSamples = (juce::int64)(clipHoldSeconds * sampleRate);
+    blockSize = 0;
+
+    for (auto& channel : channels)
+    {
+        channel.blockRmsDb = channel.blockPeakDb = unusedDb;
+        channel.clipHoldRemaining = 0;
+    }
+    endBlock();
+}
+
+void MeterEngine::beginBlock(int numActiveChannels, int numSamples) noexcept
+{
+    blockSize = numSamples;
+
+    for (int index = 0; index < maxChannels; index++)
+    {
+        auto& channel = channels[(size_t)index];
+        channel.blockRmsDb = channel.blockPeakDb = index < numActiveChannels ? silentDb : unusedDb;
+        channel.clipHoldRemaining = juce::jmax((juce::int64)0, channel.clipHoldRemaining - numSamples);
+    }
+}
+
+void MeterEngine::pushLevel(int index, float sumOfSquares, float peak) noexcept
+{
+    if (!juce::isPositiveAndBelow(index, maxChannels) || blockSize <= 0)
+        return;
+
+    auto& channel = channels[(size_t)index];
+    channel.blockRmsDb = juce::Decibels::gainToDecibels(std::sqrt(sumOfSquares / (float)blockSize));
+    channel.blockPeakDb = juce::Decibels::gainToDecibels(peak);
+
+    if (peak >= 1.0f)
+        channel.clipHoldRemaining = clipHoldSamples;
+}
+
+void MeterEngine::endBlock() noexcept
+{
+    for (auto& channel : channels)
+    {
+        channel.rmsDb.store(channel.blockRmsDb, std::memory_order_relaxed);
+        channel.peakDb.store(channel.blockPeakDb, std::memory_order_relaxed);
+        channel.clipping.store(channel.clipHoldRemaining > 0, std::memory_order_relaxed);
+    }
+}
+
+MeterEngine::Reading MeterEngine::getReading(int index) const noexcept
+{
+    if (!juce::isPositiveAndBelow(index, maxChannels))
+        return {};
+
+    const auto& channel = channels[(size_t)index];
+    return { channel.rmsDb.load(std::memory_order_relaxed), channel.peakDb.load(std::memory_order_relaxed), channel.clipping.load(std::memory_order_relaxed) };
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+#include <array>
+#include <atomic>
+
+#include "MixingEngine.h"
+
+/// Output meters handed from the audio thread to the editor without locks or allocations.
+///
+/// The capacity is fixed, every channel sits on its own cache line and holds relaxed atomics that the
+/// audio thread publishes once at the end of each block. Readers get the last published values of a
+/// channel, the audio thread does the same work whether an editor is open or not.
+class MeterEngine
+{
+public:
+    static constexpr int maxChannels = MixingEngine::maxOutputChannels;
+    static constexpr float silentDb = -100.0f; // juce::Decibels::gainToDecibels(0.0f)
+    static constexpr float unusedDb = -144.0f; // channels outside the host layout
+    static constexpr double clipHoldSeconds = 2.0;
+
+    struct Reading
+    {
+        float rmsDb = unusedDb;
+        float peakDb = unusedDb;
+        bool clipping = false; // a sample reached 0 dBFS within the clip hold time
+    };
+
+    /// Resets all meters and sets the clip hold length, call from prepareToPlay()
+    void prepare(double sampleRate) noexcept;
+
+    /// Audio thread: starts a block. Channels below `numActiveChannels` read as silent unless a level
+    /// is pushed before endBlock(), the others as unused.
+    void beginBlock(int numActiveChannels, int numSamples) noexcept;
+
+    /// Audio thread: sets the level of a channel (host order) for the current block
+    void pushLevel(int channel, float sumOfSquares, float peak) noexcept;
+
+    /// Audio thread: publishes the block's levels to readers
+    void endBlock() noexcept;
+
+    /// Any thread, wait-free
+    Reading getReading(int channel) const noexcept;
+
+private:
+    struct alignas(64) Channel
+    {
+        std::atomic<float> rmsDb { unusedDb };
+        std::atomic<float> peakDb { unusedDb };
+        std::atomic<bool> clipping { false };
+
+        // audio thread only
+        float blockRmsDb = unusedDb;
+        float blockPeakDb = unusedDb;
+        juce::int64 clipHoldRemaining = 0;
+    };
+
+    std::array<Channel, maxChannels> channels;
+    juce::int64 clipHoldSamples = 0;
+    int blockSize = 0;
+};
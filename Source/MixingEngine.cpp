@@ -0,0 +1,283 @@
+#include "MixingEngine.h"
+#include "MixingKernels.h"
+
+void MixingEngine::prepare(double sampleRate, int numInputChannels, int numOutputChannels, double rampLengthSeconds)
+{
+    stepsToTarget = (int)std::floor(rampLengthSeconds * sampleRate);
+
+    // sized for the largest configuration so a later mode change never has to allocate
+    const size_t matrixSize = (size_t)maxInputChannels * (size_t)maxRowStride;
+
+    // one extra row of padding so the first matrix can be shifted onto a 32 byte boundary
+    storage.calloc(matrixSize * 3 + alignmentInFloats);
+    auto address = reinterpret_cast<uintptr_t>(storage.get());
+    auto alignedAddress = (address + (alignmentInFloats * sizeof(float) - 1)) & ~(uintptr_t)(alignmentInFloats * sizeof(float) - 1);
+    current = reinterpret_cast<float*>(alignedAddress);
+    target = current + matrixSize;
+    step = target + matrixSize;
+
+    countdown.calloc(matrixSize);
+    activePairs.malloc(matrixSize);
+
+    kernels = &DspKernels::get();
+    setChannelCounts(numInputChannels, numOutputChannels);
+}
+
+void MixingEngine::setChannelCounts(int numInputChannels, int numOutputChannels) noexcept
+{
+    jassert(current != nullptr); // prepare() has to run first
+
+    numInputs = juce::jlimit(0, maxInputChannels, numInputChannels);
+    numOutputs = juce::jlimit(0, maxOutputChannels, numOutputChannels);
+    rowStride = (numOutputs + alignmentInFloats - 1) / alignmentInFloats * alignmentInFloats;
+
+    const size_t matrixSize = (size_t)maxInputChannels * (size_t)maxRowStride;
+    std::fill(current, current + matrixSize * 3, 0.0f);
+    std::fill(countdown.get(), countdown.get() + matrixSize, 0);
+    numRampingPairs = 0;
+    numActivePairs = 0;
+    activePairsDirty = false;
+
+    steadyKernel = MixingKernels::find(*kernels, numInputs, numOutputs);
+}
+
+void MixingEngine::fadeOut() noexcept
+{
+    for (int input_channel = 0; input_channel < numInputs; input_channel++)
+    {
+        for (int output_channel = 0; output_channel < numOutputs; output_channel++)
+        {
+            setTarget(index(input_channel, output_channel), 0.0f, stepsToTarget);
+        }
+    }
+}
+
+void MixingEngine::setTargetGain(int inputChannel, int outputChannel, float newGain)
+{
+    jassert(juce::isPositiveAndBelow(inputChannel, numInputs) && juce::isPositiveAndBelow(outputChannel, numOutputs));
+    setTarget(index(inputChannel, outputChannel), newGain, stepsToTarget);
+}
+
+void MixingEngine::setTargetGains(int inputChannel, const float* gains)
+{
+    setTargetGains(inputChannel, gains, stepsToTarget);
+}
+
+void MixingEngine::setTargetGains(int inputChannel, const float* gains, int rampLengthInSamples)
+{
+    for (int output_channel = 0; output_channel < numOutputs; output_channel++)
+    {
+        setTarget(index(inputChannel, output_channel), gains[output_channel], rampLengthInSamples);
+    }
+}
+
+void MixingEngine::setTarget(int i, float newGain, int rampLengthInSamples)
+{
+    if (std::abs(newGain) < sparseThreshold)
+        newGain = 0.0f;
+
+    // mirrors juce::LinearSmoothedValue::setTargetValue()
+    if (newGain == target[i])
+        return;
+
+    activePairsDirty = true;
+
+    if (rampLengthInSamples <= 0)
+    {
+        if (countdown[i] > 0)
+            --numRampingPairs;
+
+        current[i] = target[i] = newGain;
+        countdown[i] = 0;
+        return;
+    }
+
+    if (countdown[i] == 0)
+        ++numRampingPairs;
+
+    target[i] = newGain;
+    countdown[i] = rampLengthInSamples;
+    step[i] = (target[i] - current[i]) / (float)countdown[i];
+}
+
+void MixingEngine::snapToTargets()
+{
+    for (int input_channel = 0; input_channel < numInputs; input_channel++)
+    {
+        for (int output_channel = 0; output_channel < numOutputs; output_channel++)
+        {
+            const int i = index(input_channel, output_channel);
+            current[i] = target[i];
+            countdown[i] = 0;
+        }
+    }
+    numRampingPairs = 0;
+    activePairsDirty = true;
+}
+
+void MixingEngine::setSparseThresholdDb(float newThresholdDb)
+{
+    sparseThreshold = juce::Decibels::decibelsToGain(newThresholdDb);
+}
+
+void MixingEngine::rebuildActivePairs() noexcept
+{
+    // a pair fading to or from silence is still ramping, so it stays on the list until the ramp has finished
+    numActivePairs = 0;
+    for (int output_channel = 0; output_channel < numOutputs; output_channel++)
+    {
+        const int firstPairOfOutput = numActivePairs;
+        for (int input_channel = 0; input_channel < numInputs; input_channel++)
+        {
+            const int i = index(input_channel, output_channel);
+            if (countdown[i] > 0 || current[i] != 0.0f)
+                activePairs[numActivePairs++] = { input_channel, output_channel, i, false };
+        }
+
+        if (numActivePairs > firstPairOfOutput)
+            activePairs[numActivePairs - 1].lastForOutput = true;
+    }
+    activePairsDirty = false;
+}
+
+void MixingEngine::resetOutputLevels() noexcept
+{
+    outputLevels.fill({});
+}
+
+MixingEngine::Path MixingEngine::process(const float* const* inputs, float* const* outputs, int startSample, int numSamples)
+{
+    if (numSamples <= 0)
+        return Path::none;
+
+    // targets only change when a new coefficient frame is applied, so this runs once per published frame
+    if (activePairsDirty)
+        rebuildActivePairs();
+
+    if (numRampingPairs == 0)
+    {
+        processSteady(inputs, outputs, startSample, numSamples);
+        return Path::steady;
+    }
+
+    processRamped(inputs, outputs, startSample, numSamples);
+    return Path::ramped;
+}
+
+void MixingEngine::processSteady(const float* const* inputs, float* const* outputs, int startSample, int numSamples) noexcept
+{
+    // nothing is ramping, so `current` is the static matrix. Dense matrices go through the kernel for the
+    // current channel counts, sparse ones are cheaper pair by pair
+    if (steadyKernel != nullptr && specialisedKernelsEnabled && numActivePairs * 2 >= numInputs * numOutputs)
+    {
+        steadyKernel(inputs, outputs, current, rowStride, startSample, numSamples, outputLevels.data());
+        return;
+    }
+
+    // every active pair is a single multiply-accumulate, the last pair of each output measures the finished samples in the same loop
+    for (int pair = 0; pair < numActivePairs; pair++)
+    {
+        const auto& active = activePairs[pair];
+        float* destination = outputs[active.outputChannel];
+        if (destination == nullptr)
+            continue;
+
+        const float* source = inputs[active.inputChannel];
+        auto& level = outputLevels[(size_t)active.outputChannel];
+        if (source == nullptr)
+        {
+            if (active.lastForOutput)
+                kernels->measure(destination + startSample, numSamples, level);
+        }
+        else if (active.lastForOutput)
+        {
+            kernels->addWithMultiplyAndMeasure(destination + startSample, source + startSample, current[active.pairIndex], numSamples, level);
+        }
+        else
+        {
+            juce::FloatVectorOperations::addWithMultiply(destination + startSample, source + startSample, current[active.pairIndex], numSamples);
+        }
+    }
+}
+
+void MixingEngine::processRamped(const float* const* inputs, float* const* outputs, int startSample, int numSamples)
+{
+    for (int pair = 0; pair < numActivePairs; pair++)
+    {
+        const auto& active = activePairs[pair];
+        float* destination = outputs[active.outputChannel];
+        const float* source = inputs[active.inputChannel];
+
+        // muted inputs and outputs missing from the host still move along their ramps, otherwise the
+        // engine would never converge and the steady and silence paths would stay out of reach
+        if (destination == nullptr || source == nullptr)
+            skipPair(active.pairIndex, numSamples);
+        else
+            mixPair(active.pairIndex, source + startSample, destination + startSample, numSamples);
+
+        if (destination == nullptr)
+            continue;
+
+        // the output is still in cache right after its last pair
+        if (active.lastForOutput)
+            kernels->measure(destination + startSample, numSamples, outputLevels[(size_t)active.outputChannel]);
+    }
+}
+
+void MixingEngine::skipPair(int pairIndex, int numSamples) noexcept
+{
+    // the same control sub-blocks as mixPair(), so the gains match a pair that was mixed all along
+    int sample = 0;
+    while (countdown[pairIndex] > 0 && sample < numSamples)
+    {
+        const int subBlockLength = juce::jmin(controlBlockSize, countdown[pairIndex], numSamples - sample);
+        const int remaining = countdown[pairIndex] - subBlockLength;
+        const float endGain = remaining > 0 ? current[pairIndex] + step[pairIndex] * (float)subBlockLength : target[pairIndex];
+
+        current[pairIndex] = endGain;
+        countdown[pairIndex] = remaining;
+        sample += subBlockLength;
+
+        if (remaining == 0)
+        {
+            --numRampingPairs;
+            if (endGain == 0.0f)
+                activePairsDirty = true;
+        }
+    }
+}
+
+void MixingEngine::mixPair(int pairIndex, const float* source, float* destination, int numSamples)
+{
+    int sample = 0;
+
+    // ramping section, the gain at the end of every control sub-block is computed the way
+    // juce::LinearSmoothedValue::skip() would and the samples in between are a vectorised linear ramp
+    while (countdown[pairIndex] > 0 && sample < numSamples)
+    {
+        const int subBlockLength = juce::jmin(controlBlockSize, countdown[pairIndex], numSamples - sample);
+        const float startGain = current[pairIndex];
+        const int remaining = countdown[pairIndex] - subBlockLength;
+        const float endGain = remaining > 0 ? startGain + step[pairIndex] * (float)subBlockLength : target[pairIndex];
+
+        kernels->addWithLinearRamp(destination + sample, source + sample, startGain, (endGain - startGain) / (float)subBlockLength, subBlockLength);
+
+        current[pairIndex] = endGain;
+        countdown[pairIndex] = remaining;
+        sample += subBlockLength;
+
+        if (remaining == 0)
+        {
+            --numRampingPairs;
+            if (endGain == 0.0f)
+                activePairsDirty = true; // faded out, drop it from the list on the next block
+        }
+    }
+
+    // converged, vectorised multiply-accumulate with no smoothing work at all
+    const float gain = current[pairIndex];
+    if (sample < numSamples && gain != 0.0f)
+    {
+        juce::FloatVectorOperations::addWithMultiply(destination + sample, source + sample, gain, numSamples - sample);
+    }
+}
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+#include <array>
+
+#include "DspKernels.h"
+
+/// Mixes every input channel into every output channel through a flat input x output gain matrix.
+///
+/// Coefficients live in one contiguous, 32-byte aligned block (one padded row per input channel) and
+/// each (input, output) pair is mixed a whole block at a time with `juce::FloatVectorOperations`,
+/// which picks the SSE/AVX/NEON implementation for the running platform.
+/// Gain changes are de-zippered with the same linear ramp as `juce::LinearSmoothedValue`, evaluated
+/// at control rate: ramp end points are computed once per `controlBlockSize` samples and the samples
+/// in between are a vectorised ramp. Pairs that have reached their target skip the ramp entirely.
+/// Only pairs on the active list are mixed at all: gains below the sparse threshold are treated as
+/// silence and a pair stays on the list only while it ramps or holds a nonzero gain.
+/// The list is ordered by output so every output is finished while it is still in cache, which is
+/// where its RMS and peak sums are accumulated for the meters.
+class MixingEngine
+{
+public:
+    MixingEngine() = default;
+
+    /// How a call to process() mixed its block
+    enum class Path
+    {
+        none,
+        ramped, // at least one pair was still ramping towards its target
+        steady // every pair had converged, mixed from the static matrix
+    };
+
+    /// The path of a block mixed in several process() calls, ramped if any of them ramped
+    static Path combine(Path first, Path second) noexcept
+    {
+        if (first == Path::none)
+            return second;
+        if (second == Path::none)
+            return first;
+        return first == Path::steady && second == Path::steady ? Path::steady : Path::ramped;
+    }
+
+    /// Sums over the samples mixed into one output since the last resetOutputLevels()
+    using OutputLevel = DspLevel;
+
+    /// Mixes every pair of a converged matrix in one go, see MixingKernels
+    using SteadyKernel = DspKernelSet::SteadyKernel;
+
+    /// Upper bounds for every per-channel buffer the audio thread touches
+    static constexpr int maxInputChannels = 8;
+    static constexpr int maxOutputChannels = 64;
+
+    /// Number of samples between two ramp end point evaluations
+    static constexpr int controlBlockSize = 32;
+
+    /// Target gains quieter than this are treated as zero and their pairs dropped from the mix
+    static constexpr float defaultSparseThresholdDb = -120.0f;
+
+    /// Allocates the matrix for the largest channel counts, picks up the currently selected
+    /// DspKernels variant and configures the given counts, call from a non-realtime thread
+    void prepare(double sampleRate, int numInputChannels, int numOutputChannels, double rampLengthSeconds = 0.01);
+
+    /// Switches to other channel counts inside the preallocated matrix, every pair restarts from silence
+    /// and fades in with the next targets. Realtime safe, never allocates.
+    void setChannelCounts(int numInputChannels, int numOutputChannels) noexcept;
+
+    /// Ramps every pair to silence over the regular ramp length, isConverged() turns true once it is quiet
+    void fadeOut() noexcept;
+
+    int getNumInputChannels() const { return numInputs; }
+    int getNumOutputChannels() const { return numOutputs; }
+
+    /// Number of samples a pair takes to reach a new target
+    int getRampLengthInSamples() const noexcept { return stepsToTarget; }
+
+    /// Sets the gain that the (input, output) pair will ramp towards
+    void setTargetGain(int inputChannel, int outputChannel, float newGain);
+
+    /// Sets all targets of one input row, `gains` is expected to hold `getNumOutputChannels()` values
+    void setTargetGains(int inputChannel, const float* gains);
+
+    /// Same as above but reaches the targets after `rampLengthInSamples`, used for control rate updates
+    void setTargetGains(int inputChannel, const float* gains, int rampLengthInSamples);
+
+    /// Jumps every pair to its target without ramping
+    void snapToTargets();
+
+    /// Changes the level below which a target gain counts as silent, applies to targets set afterwards
+    void setSparseThresholdDb(float newThresholdDb);
+
+    /// Allows the steady path to use the kernel specialised for the current channel counts (the default)
+    void setSpecialisedKernelsEnabled(bool shouldBeEnabled) noexcept { specialisedKernelsEnabled = shouldBeEnabled; }
+
+    /// Number of pairs mixed by the last process() call, out of inputs x outputs
+    int getNumActivePairs() const noexcept { return numActivePairs; }
+
+    float getCurrentGain(int inputChannel, int outputChannel) const { return current[index(inputChannel, outputChannel)]; }
+    float getTargetGain(int inputChannel, int outputChannel) const { return target[index(inputChannel, outputChannel)]; }
+
+    /// Adds the mix of `inputs` into `outputs` and accumulates the output levels.
+    /// A nullptr input is skipped without advancing its ramps (missing or muted channel),
+    /// a nullptr output is skipped (channel not present in the host layout).
+    /// `outputs` may point straight into the host buffer in any channel order. Returns the path it took,
+    /// `none` for an empty block.
+    Path process(const float* const* inputs, float* const* outputs, int startSample, int numSamples);
+
+    /// Starts a new metering period, call once per host block before process()
+    void resetOutputLevels() noexcept;
+
+    /// Level sums of an output, divide `sumOfSquares` by the samples processed for the mean square
+    const OutputLevel& getOutputLevel(int outputChannel) const noexcept { return outputLevels[(size_t)outputChannel]; }
+
+    /// True once every pair has reached its target, the next process() call will take the steady path
+    bool isConverged() const noexcept { return numRampingPairs == 0; }
+
+private:
+    int index(int inputChannel, int outputChannel) const { return inputChannel * rowStride + outputChannel; }
+    void setTarget(int pairIndex, float newGain, int rampLengthInSamples);
+    void rebuildActivePairs() noexcept;
+    void processRamped(const float* const* inputs, float* const* outputs, int startSample, int numSamples);
+    void processSteady(const float* const* inputs, float* const* outputs, int startSample, int numSamples) noexcept;
+    void mixPair(int pairIndex, const float* source, float* destination, int numSamples);
+    void skipPair(int pairIndex, int numSamples) noexcept; // advances the ramp of a pair that is not mixed
+
+    static constexpr int alignmentInFloats = 8; // 32 bytes covers AVX
+    static constexpr int maxRowStride = (maxOutputChannels + alignmentInFloats - 1) / alignmentInFloats * alignmentInFloats;
+
+    int numInputs = 0;
+    int numOutputs = 0;
+    int rowStride = 0;
+    int stepsToTarget = 0;
+
+    juce::HeapBlock<float> storage;
+    float* current = nullptr;
+    float* target = nullptr;
+    float* step = nullptr;
+    juce::HeapBlock<int> countdown;
+    int numRampingPairs = 0;
+
+    struct ActivePair
+    {
+        int inputChannel;
+        int outputChannel;
+        int pairIndex;
+        bool lastForOutput; // the output is complete once this pair has been mixed
+    };
+
+    float sparseThreshold = juce::Decibels::decibelsToGain(defaultSparseThresholdDb);
+    juce::HeapBlock<ActivePair> activePairs;
+    int numActivePairs = 0;
+    bool activePairsDirty = false;
+
+    std::array<OutputLevel, maxOutputChannels> outputLevels {};
+
+    const DspKernelSet* kernels = &DspKernels::get();
+    SteadyKernel steadyKernel = nullptr; // picked in setChannelCounts(), nullptr for channel counts without a specialisation
+    bool specialisedKernelsEnabled = true;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MixingEngine)
+};
@@ -0,0 +1,74 @@
+#include "MixingKernels.h"
+
+MixingEngine::SteadyKernel MixingKernels::find(const DspKernelSet& kernels, int numInputChannels, int numOutputChannels)
+{
+    if (numInputChannels < 1 || numInputChannels > DspKernelSet::numSteadyInputCounts)
+        return nullptr;
+
+    for (int outputs_index = 0; outputs_index < DspKernelSet::numSteadyOutputCounts; outputs_index++)
+    {
+        if (DspKernelSet::steadyOutputCounts[outputs_index] == numOutputChannels)
+            return kernels.steady[numInputChannels - 1][outputs_index];
+    }
+    return nullptr;
+}
+
+juce::String MixingKernels::runBenchmark(double sampleRate, int blockSize, int numBlocks)
+{
+    juce::String report;
+    juce::Random random(0x4d31);
+    juce::AudioBuffer<float> inputBuffer(MixingEngine::maxInputChannels, blockSize);
+    juce::AudioBuffer<float> outputBuffer(MixingEngine::maxOutputChannels, blockSize);
+    for (int channel = 0; channel < inputBuffer.getNumChannels(); channel++)
+    {
+        for (int sample = 0; sample < blockSize; sample++)
+        {
+            inputBuffer.setSample(channel, sample, random.nextFloat() * 2.0f - 1.0f);
+        }
+    }
+
+    std::array<const float*, MixingEngine::maxInputChannels> inputs {};
+    std::array<float*, MixingEngine::maxOutputChannels> outputs {};
+    for (int channel = 0; channel < MixingEngine::maxInputChannels; channel++)
+        inputs[(size_t)channel] = inputBuffer.getReadPointer(channel);
+    for (int channel = 0; channel < MixingEngine::maxOutputChannels; channel++)
+        outputs[(size_t)channel] = outputBuffer.getWritePointer(channel);
+
+    report << "kernels: " << DspKernels::getName(DspKernels::get().isa) << "\n";
+    for (int numInputChannels = 1; numInputChannels <= DspKernelSet::numSteadyInputCounts; numInputChannels++)
+    {
+        for (int numOutputChannels : DspKernelSet::steadyOutputCounts)
+        {
+            MixingEngine engine;
+            engine.prepare(sampleRate, numInputChannels, numOutputChannels);
+            for (int input_channel = 0; input_channel < numInputChannels; input_channel++)
+            {
+                for (int output_channel = 0; output_channel < numOutputChannels; output_channel++)
+                {
+                    engine.setTargetGain(input_channel, output_channel, random.nextFloat());
+                }
+            }
+            engine.snapToTargets();
+
+            double milliseconds[2] = {};
+            for (int pass = 0; pass < 2; pass++)
+            {
+                engine.setSpecialisedKernelsEnabled(pass == 0);
+                outputBuffer.clear();
+                const auto startTicks = juce::Time::getHighResolutionTicks();
+                for (int block = 0; block < numBlocks; block++)
+                {
+                    engine.resetOutputLevels();
+                    engine.process(inputs.data(), outputs.data(), 0, blockSize);
+                }
+                milliseconds[pass] = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks) * 1000.0;
+            }
+
+            report << numInputChannels << " -> " << numOutputChannels
+                   << " | specialised: " << juce::String(milliseconds[0], 3) << " ms"
+                   << " | generic: " << juce::String(milliseconds[1], 3) << " ms"
+                   << " | speedup: " << juce::String(milliseconds[1] / juce::jmax(milliseconds[0], 1.0e-6), 2) << "x\n";
+        }
+    }
+    return report;
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "MixingEngine.h"
+
+/// Define `M1_MIXER_BENCHMARK=1` to log a comparison of the specialised and generic mixing paths
+/// for every supported channel count pair from prepareToPlay()
+#ifndef M1_MIXER_BENCHMARK
+    #define M1_MIXER_BENCHMARK 0
+#endif
+
+/// Steady state mixing kernels specialised on the channel counts of the Mach1Encode modes.
+///
+/// With the counts known at compile time the per-output loop over the inputs is fully unrolled and the
+/// gains of the current output stay in registers. Every input mode lands on one of a handful of counts
+/// (Mono 1, Stereo 2, LCR 3, Quad/LCRS/AFormat/1OA 4, 5.0 5, 5.1 6) and every output mode on
+/// M1Spatial_4/8/14, so one kernel per count pair covers all of the supported mode pairs.
+/// The kernels themselves live in DspKernelsImpl.h and are built once per instruction set.
+namespace MixingKernels
+{
+/// The kernel of `kernels` for the given channel counts, nullptr if there is none and the generic path has to be used
+MixingEngine::SteadyKernel find(const DspKernelSet& kernels, int numInputChannels, int numOutputChannels);
+
+/// Times the specialised kernel of every supported count pair against the generic path and
+/// returns a human readable report, slow, never call from the audio thread
+juce::String runBenchmark(double sampleRate, int blockSize, int numBlocks);
+} // namespace MixingKernels
@@ -0,0 +1,204 @@
+#include "MonitorOrientationFeed.h"
+
+namespace
+{
+struct Quaternion
+{
+    double w, x, y, z;
+};
+
+// yaw about the vertical axis, then pitch, then roll
+Quaternion toQuaternion(const MonitorOrientationFeed::Orientation& orientation)
+{
+    const double halfYaw = juce::degreesToRadians((double)orientation.yaw) * 0.5;
+    const double halfPitch = juce::degreesToRadians((double)orientation.pitch) * 0.5;
+    const double halfRoll = juce::degreesToRadians((double)orientation.roll) * 0.5;
+    const double cy = std::cos(halfYaw), sy = std::sin(halfYaw);
+    const double cp = std::cos(halfPitch), sp = std::sin(halfPitch);
+    const double cr = std::cos(halfRoll), sr = std::sin(halfRoll);
+
+    return { cr * cp * cy + sr * sp * sy,
+             sr * cp * cy - cr * sp * sy,
+             cr * sp * cy + sr * cp * sy,
+             cr * cp * sy - sr * sp * cy };
+}
+
+MonitorOrientationFeed::Orientation toOrientation(const Quaternion& q)
+{
+    const double sinPitch = juce::jlimit(-1.0, 1.0, 2.0 * (q.w * q.y - q.z * q.x));
+
+    MonitorOrientationFeed::Orientation orientation;
+    orientation.yaw = (float)juce::radiansToDegrees(std::atan2(2.0 * (q.w * q.z + q.x * q.y), 1.0 - 2.0 * (q.y * q.y + q.z * q.z)));
+    orientation.pitch = (float)juce::radiansToDegrees(std::asin(sinPitch));
+    orientation.roll = (float)juce::radiansToDegrees(std::atan2(2.0 * (q.w * q.x + q.y * q.z), 1.0 - 2.0 * (q.x * q.x + q.y * q.y)));
+    return orientation;
+}
+
+// `amount` above 1 keeps rotating at the same angular velocity
+Quaternion slerp(const Quaternion& from, Quaternion to, double amount)
+{
+    double dot = from.w * to.w + from.x * to.x + from.y * to.y + from.z * to.z;
+    if (dot < 0.0)
+    {
+        // the shorter way round
+        to = { -to.w, -to.x, -to.y, -to.z };
+        dot = -dot;
+    }
+
+    double fromWeight = 1.0 - amount, toWeight = amount;
+    if (dot < 0.9995)
+    {
+        const double angle = std::acos(dot);
+        const double sinAngle = std::sin(angle);
+        fromWeight = std::sin((1.0 - amount) * angle) / sinAngle;
+        toWeight = std::sin(amount * angle) / sinAngle;
+    }
+
+    Quaternion result = { fromWeight * from.w + toWeight * to.w,
+                          fromWeight * from.x + toWeight * to.x,
+                          fromWeight * from.y + toWeight * to.y,
+                          fromWeight * from.z + toWeight * to.z };
+    const double length = std::sqrt(result.w * result.w + result.x * result.x + result.y * result.y + result.z * result.z);
+    return { result.w / length, result.x / length, result.y / length, result.z / length };
+}
+
+float unwrapNear(float degrees, float reference)
+{
+    return reference + std::remainder(degrees - reference, 360.0f);
+}
+}
+
+void MonitorOrientationFeed::push(const Orientation& orientation, double receivedMs, std::optional<juce::uint32> senderTimestampUs) noexcept
+{
+    const auto index = numPushed.load(std::memory_order_relaxed);
+    auto& slot = slots[index % historySize];
+    const juce::uint32 stableSequence = (index / historySize) * 2 + 2;
+
+    slot.sequence.store(stableSequence - 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.timeMs.store(receivedMs, std::memory_order_relaxed);
+    slot.yaw.store(orientation.yaw, std::memory_order_relaxed);
+    slot.pitch.store(orientation.pitch, std::memory_order_relaxed);
+    slot.roll.store(orientation.roll, std::memory_order_relaxed);
+    slot.sequence.store(stableSequence, std::memory_order_release);
+    numPushed.store(index + 1, std::memory_order_release);
+
+    updateStatistics(receivedMs, senderTimestampUs);
+}
+
+bool MonitorOrientationFeed::readSample(juce::uint32 index, Sample& sample) const noexcept
+{
+    const auto& slot = slots[index % historySize];
+    const juce::uint32 stableSequence = (index / historySize) * 2 + 2;
+
+    if (slot.sequence.load(std::memory_order_acquire) != stableSequence)
+        return false;
+
+    sample.timeMs = slot.timeMs.load(std::memory_order_relaxed);
+    sample.orientation.yaw = slot.yaw.load(std::memory_order_relaxed);
+    sample.orientation.pitch = slot.pitch.load(std::memory_order_relaxed);
+    sample.orientation.roll = slot.roll.load(std::memory_order_relaxed);
+
+    // the slot must not have been reused while it was copied
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return slot.sequence.load(std::memory_order_relaxed) == stableSequence;
+}
+
+bool MonitorOrientationFeed::getOrientation(double timeMs, Orientation& orientation) const noexcept
+{
+    auto interpolateAt = [](const Sample& earlier, const Sample& later, double time) {
+        const double interval = later.timeMs - earlier.timeMs;
+        const double amount = interval > 0.0 ? (time - earlier.timeMs) / interval : 1.0;
+        auto result = toOrientation(slerp(toQuaternion(earlier.orientation), toQuaternion(later.orientation), amount));
+        result.yaw = unwrapNear(result.yaw, later.orientation.yaw); // keep the range the helper uses
+        return result;
+    };
+
+    // a retry is only needed when the writer laps this reader
+    for (int attempt = 0; attempt < 4; attempt++)
+    {
+        const auto count = numPushed.load(std::memory_order_acquire);
+        if (count == 0)
+            return false;
+
+        Sample newest;
+        if (!readSample(count - 1, newest))
+            continue;
+
+        if (count == 1)
+        {
+            orientation = newest.orientation;
+            return true;
+        }
+
+        Sample previous;
+        if (!readSample(count - 2, previous))
+            continue;
+
+        if (timeMs >= newest.timeMs)
+        {
+            // no further ahead than one more arrival interval, a lone jump would otherwise keep spinning
+            const double horizon = juce::jmin(maxExtrapolationMs, newest.timeMs - previous.timeMs);
+            orientation = interpolateAt(previous, newest, juce::jmin(timeMs, newest.timeMs + horizon));
+            return true;
+        }
+
+        // walk back to the two samples around the query time
+        const juce::uint32 oldest = count > (juce::uint32)historySize ? count - (juce::uint32)historySize : 0;
+        Sample later = newest, earlier = previous;
+        bool lapped = false;
+        for (juce::uint32 index = count - 2; earlier.timeMs > timeMs; index--)
+        {
+            if (index == oldest)
+            {
+                // older than the history reaches
+                orientation = earlier.orientation;
+                return true;
+            }
+
+            later = earlier;
+            if (!readSample(index - 1, earlier))
+            {
+                lapped = true;
+                break;
+            }
+        }
+
+        if (!lapped)
+        {
+            orientation = interpolateAt(earlier, later, timeMs);
+            return true;
+        }
+    }
+    return false;
+}
+
+void MonitorOrientationFeed::updateStatistics(double receivedMs, std::optional<juce::uint32> senderTimestampUs) noexcept
+{
+    auto& stats = writerStatistics;
+
+    // smoothed like the RTP interarrival jitter, over about 16 samples
+    if (stats.numSamples > 0)
+    {
+        const double interval = receivedMs - lastReceivedMs;
+        stats.meanIntervalMs = stats.numSamples == 1 ? interval : stats.meanIntervalMs + (interval - stats.meanIntervalMs) / 16.0;
+        stats.jitterMs += (std::abs(interval - stats.meanIntervalMs) - stats.jitterMs) / 16.0;
+        stats.maxIntervalMs = juce::jmax(stats.maxIntervalMs, interval);
+    }
+    lastReceivedMs = receivedMs;
+    stats.numSamples++;
+
+    if (senderTimestampUs.has_value())
+    {
+        const auto receivedUs = (juce::uint32)(juce::int64)(receivedMs * 1000.0);
+        const double latency = (double)(juce::uint32)(receivedUs - *senderTimestampUs) / 1000.0;
+        if (latency <= maxLatencyMs)
+        {
+            stats.meanLatencyMs = stats.hasLatency ? stats.meanLatencyMs + (latency - stats.meanLatencyMs) / 16.0 : latency;
+            stats.maxLatencyMs = juce::jmax(stats.maxLatencyMs, latency);
+            stats.hasLatency = true;
+        }
+    }
+
+    statistics.update([&stats](Statistics& published) { published = stats; });
+}
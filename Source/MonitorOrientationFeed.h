@@ -0,0 +1,81 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+#include <array>
+#include <atomic>
+#include <optional>
+
+#include "SnapshotBuffer.h"
+
+/// Timestamped history of the monitor orientation the helper streams, readable from any thread.
+///
+/// One thread pushes every received sample into a fixed ring of seqlocked slots. Readers ask for the
+/// orientation at any time: between two samples it is slerped, past the newest sample it is
+/// extrapolated with the last angular velocity for one arrival interval (at most `maxExtrapolationMs`)
+/// and held after that. Arrival interval, jitter and, when the helper stamps its samples, transport
+/// latency are tracked as running statistics.
+class MonitorOrientationFeed
+{
+public:
+    static constexpr int historySize = 64;
+    static constexpr double maxExtrapolationMs = 50.0;
+    static constexpr double maxLatencyMs = 1000.0; // larger differences mean the clocks are unrelated
+
+    /// Degrees, as the helper sends them
+    struct Orientation
+    {
+        float yaw = 0.0f;
+        float pitch = 0.0f;
+        float roll = 0.0f;
+    };
+
+    struct Statistics
+    {
+        juce::uint32 numSamples = 0;
+        double meanIntervalMs = 0.0;
+        double jitterMs = 0.0; // smoothed deviation of the interval from its mean
+        double maxIntervalMs = 0.0;
+        bool hasLatency = false;
+        double meanLatencyMs = 0.0;
+        double maxLatencyMs = 0.0;
+    };
+
+    /// The clock every time in here is measured with
+    static double now() noexcept { return juce::Time::getMillisecondCounterHiRes(); }
+
+    /// Writer, one thread only: records a sample received at `receivedMs`. `senderTimestampUs` are the
+    /// microseconds of the system's monotonic clock when the helper sent it, truncated to 32 bits.
+    void push(const Orientation& orientation, double receivedMs, std::optional<juce::uint32> senderTimestampUs = std::nullopt) noexcept;
+
+    /// Any thread: the orientation at `timeMs`, false if no sample was received yet
+    bool getOrientation(double timeMs, Orientation& orientation) const noexcept;
+
+    /// Any thread
+    Statistics getStatistics() const noexcept { return statistics.read(); }
+
+private:
+    struct Sample
+    {
+        double timeMs = 0.0;
+        Orientation orientation;
+    };
+
+    struct Slot
+    {
+        std::atomic<juce::uint32> sequence { 0 }; // odd while the slot is written
+        std::atomic<double> timeMs { 0.0 };
+        std::atomic<float> yaw { 0.0f }, pitch { 0.0f }, roll { 0.0f };
+    };
+
+    bool readSample(juce::uint32 index, Sample& sample) const noexcept;
+    void updateStatistics(double receivedMs, std::optional<juce::uint32> senderTimestampUs) noexcept;
+
+    std::array<Slot, historySize> slots;
+    std::atomic<juce::uint32> numPushed { 0 };
+
+    // writer only
+    double lastReceivedMs = 0.0;
+    Statistics writerStatistics;
+    SnapshotBuffer<Statistics> statistics;
+};
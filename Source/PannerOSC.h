@@ -2,31 +2,43 @@
 
 #include <JuceHeader.h>
 #include "AlertData.h"
+#include "PannerOSCHub.h"
+#include "PannerTelemetry.h"
 
 class M1PannerAudioProcessor;
 
-class PannerOSC : public juce::DeletedAtShutdown, private juce::OSCSender, private juce::OSCReceiver, private juce::OSCReceiver::Listener<juce::OSCReceiver::MessageLoopCallback>
+/// The OSC endpoint of one panner instance, a client of the process-wide PannerOSCHub
+class PannerOSC : private PannerOSCHub::Client
 {
 public:
     M1PannerAudioProcessor* processor = nullptr;
     PannerOSC(M1PannerAudioProcessor* processor);
-    ~PannerOSC();
+    ~PannerOSC() override;
 
     bool init(int helperPort);
-    bool initFromSettings(const std::string& jsonSettingsFilePath);
-    int helperPort = 0, port = 0;
+    int pannerId = 0; // identifies this panner towards the helper
     std::function<void(juce::OSCMessage msg)> messageReceived;
-    void oscMessageReceived(const juce::OSCMessage& msg) override;
-    juce::uint32 lastMessageTime = 0;
+    std::function<void()> onTick; // periodic message thread work, driven by the shared hub tick
+    std::function<PannerTelemetry::State()> telemetrySource; // polled at the telemetry rate
 
-    void update();
     void AddListener(std::function<void(juce::OSCMessage msg)> messageReceived);
     bool Send(const juce::OSCMessage& msg);
     bool isConnected();
     bool sendRequestForCurrentChannelConfig();
-    bool sendPannerSettings(int state);
-    bool sendPannerSettings(int state, std::string displayName, juce::OSCColour colour, int input_mode, float azimuth, float elevation, float diverge, float gain, int panner_mode, bool gain_comp_active, bool st_auto_orbit, float st_azimuth, float st_spread);
+
+    /// The next telemetry update is a full `/panner-settings` keyframe
+    void requestTelemetryKeyframe() { telemetry.requestKeyframe(); }
+
+    /// Sends the telemetry update now rather than on the next tick while the hub uses the shared
+    /// memory rings, where a message costs no syscall. Message thread only.
+    void sendTelemetryNow();
 
 private:
-    bool is_connected = false; // used to track connection with helper utility
+    void oscMessageReceived(const juce::OSCMessage& msg) override;
+    void oscTick() override;
+    void telemetryTick() override;
+
+    juce::SharedResourcePointer<PannerOSCHub> hub;
+    PannerTelemetry telemetry;
+    bool wasConnected = false;
 };
@@ -0,0 +1,436 @@
+#include "PannerOSCHub.h"
+
+#include "RealtimeGuard.h"
+
+namespace
+{
+juce::File getSettingsFile()
+{
+    // We will assume the folders are properly created during the installation step
+    juce::File settingsFile;
+    // Using common support files installation location
+    juce::File m1SupportDirectory = juce::File::getSpecialLocation(juce::File::commonApplicationDataDirectory);
+
+    if ((juce::SystemStats::getOperatingSystemType() & juce::SystemStats::MacOSX) != 0)
+    {
+        // test for any mac OS
+        settingsFile = m1SupportDirectory.getChildFile("Application Support").getChildFile("Mach1");
+    }
+    else
+    {
+        settingsFile = m1SupportDirectory.getChildFile("Mach1");
+    }
+    return settingsFile.getChildFile("settings.json");
+}
+}
+
+PannerOSCHub::PannerOSCHub()
+    : nextPannerId(minPannerId + juce::Random::getSystemRandom().nextInt(pannerIdRange))
+{
+    const auto settingsFile = getSettingsFile();
+    DBG("Opening settings file: " + settingsFile.getFullPathName().quoted());
+
+    // finds the server port via the settings json file, once for every panner in the process
+    settingsFileFound = settingsFile.existsAsFile();
+    if (settingsFileFound)
+    {
+        juce::var mainVar = juce::JSON::parse(settingsFile);
+        start(mainVar["helperPort"]);
+        if (mainVar.hasProperty("telemetryRate"))
+            telemetryRateHz = juce::jlimit(1, maxTelemetryRateHz, (int)mainVar["telemetryRate"]);
+        if (mainVar.hasProperty("livenessWindowMs"))
+            keepAlive.setLivenessWindow((juce::uint32)juce::jmax(0, (int)mainVar["livenessWindowMs"]));
+        if (mainVar.hasProperty("sharedMemoryTransport"))
+            sharedMemoryEnabled = (bool)mainVar["sharedMemoryTransport"];
+    }
+
+    juce::OSCReceiver::addListener(this);
+    startTimerHz(telemetryRateHz);
+}
+
+PannerOSCHub::~PannerOSCHub()
+{
+    stopTimer();
+    juce::OSCReceiver::removeListener(this);
+
+    // the goodbyes of the last panners
+    flush();
+
+    closeSharedMemory();
+    cancelPendingUpdate();
+
+    sender.disconnect();
+    juce::OSCReceiver::disconnect();
+}
+
+int PannerOSCHub::addClient(Client* client)
+{
+    const RealtimeGuard::ScopedLock sl(lock);
+
+    // unique in the process, the random start keeps other processes' panners apart
+    const int pannerId = nextPannerId;
+    nextPannerId = nextPannerId + 1 < minPannerId + pannerIdRange ? nextPannerId + 1 : minPannerId;
+    clients.push_back({ client, pannerId });
+    return pannerId;
+}
+
+bool PannerOSCHub::isAddressedToPanner(const juce::OSCAddressPattern& address)
+{
+    // the helper asks a panner it only received deltas from for its full state
+    return address == "/panner-keyframe-request";
+}
+
+void PannerOSCHub::removeClient(Client* client)
+{
+    // dispatches run on the message thread too, so none can be inside this client's callbacks
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    const RealtimeGuard::ScopedLock sl(lock);
+    clients.erase(std::remove_if(clients.begin(), clients.end(), [client](const ClientEntry& entry) { return entry.client == client; }), clients.end());
+    clientsRemoved++;
+}
+
+template <typename Callback>
+void PannerOSCHub::forEachClient(Callback&& callback)
+{
+    std::vector<ClientEntry> snapshot;
+    juce::uint32 removedBefore = 0;
+    {
+        const RealtimeGuard::ScopedLock sl(lock);
+        snapshot = clients;
+        removedBefore = clientsRemoved.load();
+    }
+
+    for (const auto& entry : snapshot)
+    {
+        // an earlier client's host callback may have deleted a later one
+        if (clientsRemoved.load() != removedBefore)
+        {
+            const RealtimeGuard::ScopedLock sl(lock);
+            if (std::none_of(clients.begin(), clients.end(), [&entry](const ClientEntry& attached) { return attached.client == entry.client; }))
+                continue;
+        }
+        callback(entry);
+    }
+}
+
+bool PannerOSCHub::start(int newHelperPort)
+{
+    const RealtimeGuard::ScopedLock sl(lock);
+
+    if (newHelperPort > 0 && helperPort <= 0)
+        helperPort = newHelperPort;
+
+    if (!receiving)
+        receiving = bindReceiver();
+
+    // every panner instance calls this, the backoff keeps them from hammering a missing helper
+    if (receiving && !connected && keepAlive.isRetryDue(juce::Time::getMillisecondCounter()))
+        connectToHelper();
+
+    return receiving;
+}
+
+void PannerOSCHub::setLivenessWindow(int windowMs)
+{
+    const RealtimeGuard::ScopedLock sl(lock);
+    keepAlive.setLivenessWindow((juce::uint32)juce::jmax(0, windowMs));
+}
+
+void PannerOSCHub::setTelemetryRate(int rateHz)
+{
+    // the timer can only be restarted from the message thread
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    const RealtimeGuard::ScopedLock sl(lock);
+    telemetryRateHz = juce::jlimit(1, maxTelemetryRateHz, rateHz);
+    startTimerHz(telemetryRateHz);
+}
+
+bool PannerOSCHub::bindReceiver()
+{
+    // Try to find an available port for the receiver
+    const int maxAttempts = 100;
+
+    juce::DatagramSocket socket(false);
+    socket.setEnablePortReuse(false);
+
+    for (int attempt = 0; attempt < maxAttempts; attempt++)
+    {
+        const int candidate = 10000 + juce::Random::getSystemRandom().nextInt(1000);
+        if (socket.bindToPort(candidate))
+        {
+            socket.shutdown(); // shutdown port to not block the juce::OSCReceiver::connect return
+            if (juce::OSCReceiver::connect(candidate))
+            {
+                port = candidate;
+                return true;
+            }
+        }
+    }
+
+    port = 0;
+    return false;
+}
+
+void PannerOSCHub::connectToHelper()
+{
+    if (helperPort <= 0)
+        return;
+
+    const auto now = juce::Time::getMillisecondCounter();
+    senderConnected = senderConnected || sender.connect("127.0.0.1", helperPort);
+    if (!senderConnected)
+    {
+        keepAlive.failed(now);
+        return;
+    }
+
+    juce::OSCMessage msg = juce::OSCMessage(juce::OSCAddressPattern("/m1-register-plugin"));
+    msg.addInt32(port);
+    helperCapabilities = 0; // the helper repeats them with its next ping
+    connected = sender.send(msg);
+    if (!connected)
+    {
+        keepAlive.failed(now);
+        DBG("[OSC] Registration failed, next attempt in " + juce::String(keepAlive.getRetryDelay()) + " ms");
+        return;
+    }
+
+    keepAlive.attempted(now);
+    DBG("[OSC] Registered: " + std::to_string(port.load()));
+    offerSharedMemory();
+}
+
+void PannerOSCHub::offerSharedMemory()
+{
+    if (!sharedMemoryEnabled || sharedMemory != nullptr)
+        return;
+
+    // the polling thread only wakes the message thread, messages are dispatched from there
+    sharedMemory = SharedMemoryTransport::create(port, [this] { triggerAsyncUpdate(); });
+    if (sharedMemory == nullptr)
+    {
+        DBG("[OSC] Could not create the shared memory rings, staying on UDP");
+        return;
+    }
+
+    juce::OSCMessage msg = juce::OSCMessage(juce::OSCAddressPattern("/m1-shm-offer"));
+    msg.addInt32(port);
+    msg.addInt32(SharedMemoryTransport::version);
+    msg.addString(sharedMemory->getOutboundPath()); // panner -> helper
+    msg.addString(sharedMemory->getInboundPath()); // helper -> panner
+    if (!sender.send(msg))
+    {
+        sharedMemory.reset();
+        return;
+    }
+    sharedMemoryOfferTime = juce::Time::getMillisecondCounter();
+}
+
+void PannerOSCHub::closeSharedMemory()
+{
+    if (sharedMemory == nullptr)
+        return;
+
+    if (sharedMemoryActive && senderConnected)
+    {
+        juce::OSCMessage msg = juce::OSCMessage(juce::OSCAddressPattern("/m1-shm-close"));
+        msg.addInt32(port);
+        sender.send(msg);
+    }
+
+    sharedMemoryActive = false;
+    sharedMemory.reset();
+    DBG("[OSC] Shared memory transport closed, using UDP");
+}
+
+bool PannerOSCHub::sendNow(const juce::OSCMessage& msg)
+{
+    if (sharedMemoryActive)
+    {
+        if (sharedMemory->send(msg))
+            return true;
+
+        // the helper stopped draining its ring
+        closeSharedMemory();
+    }
+    return senderConnected && sender.send(msg);
+}
+
+bool PannerOSCHub::queue(int pannerId, const juce::OSCMessage& msg)
+{
+    const RealtimeGuard::ScopedLock sl(lock);
+    if (!connected)
+        return false;
+
+    // the rings cost no syscall per message, only UDP is worth bundling. Behind anything still queued
+    // the message waits for the tick to keep the order
+    if (sharedMemoryActive && pending.empty() && sendNow(msg))
+        return true;
+
+    queueRegardless(pannerId, msg);
+    return true;
+}
+
+void PannerOSCHub::queueRegardless(int pannerId, const juce::OSCMessage& msg)
+{
+    const RealtimeGuard::ScopedLock sl(lock);
+
+    // only the newest state of a panner is worth sending
+    for (auto& queued : pending)
+    {
+        if (queued.pannerId == pannerId && queued.message.getAddressPattern() == msg.getAddressPattern())
+        {
+            queued.message = msg;
+            return;
+        }
+    }
+    pending.push_back({ pannerId, msg });
+}
+
+void PannerOSCHub::oscMessageReceived(const juce::OSCMessage& msg)
+{
+    bool addressed = false;
+    int targetId = 0;
+    {
+        const RealtimeGuard::ScopedLock sl(lock);
+        keepAlive.heard(juce::Time::getMillisecondCounter());
+
+        if (msg.getAddressPattern() == "/m1-ping")
+        {
+            // the helper knows this port, no need to register again. Helpers that predate the capabilities send no arguments
+            connected = true;
+            helperCapabilities = msg.size() > 0 && msg[0].isInt32() ? msg[0].getInt32() : 0;
+
+            // one answer for every panner behind this port, the rings cost no syscall so they don't wait for the bundle
+            juce::OSCMessage response = juce::OSCMessage(juce::OSCAddressPattern("/m1-status-plugin"));
+            response.addInt32(port);
+            if (!sharedMemoryActive || !sendNow(response))
+                queueRegardless(statusReplyId, response);
+            return;
+        }
+
+        if (msg.getAddressPattern() == "/m1-shm-accept")
+        {
+            // the helper answers through the inbound ring once it has mapped both
+            sharedMemoryActive = sharedMemory != nullptr;
+            DBG("[OSC] Helper accepted the shared memory transport");
+            return;
+        }
+
+        // route messages addressed to one panner, broadcast the rest
+        addressed = isAddressedToPanner(msg.getAddressPattern());
+        if (addressed && (msg.size() == 0 || !msg[0].isInt32()))
+            return;
+        targetId = addressed ? msg[0].getInt32() : 0;
+    }
+
+    forEachClient([&](const ClientEntry& entry) {
+        if (!addressed || entry.pannerId == targetId)
+            entry.client->oscMessageReceived(msg);
+    });
+}
+
+void PannerOSCHub::timerCallback()
+{
+    // the clients are called without the lock, they call into the host and the editors poll the hub
+    const auto now = juce::Time::getMillisecondCounter();
+    if (now - lastHousekeepingTime >= (juce::uint32)housekeepingIntervalMs)
+    {
+        lastHousekeepingTime = now;
+
+        {
+            const RealtimeGuard::ScopedLock sl(lock);
+            if (!connected && receiving && keepAlive.isRetryDue(now))
+                connectToHelper();
+
+            if (connected && !keepAlive.isAlive(now))
+            {
+                // a different helper may answer next time
+                connected = false;
+                helperCapabilities = 0;
+                keepAlive.failed(now);
+                closeSharedMemory();
+            }
+
+            if (sharedMemory != nullptr && !sharedMemoryActive && (now - sharedMemoryOfferTime) > sharedMemoryOfferTimeoutMs)
+            {
+                DBG("[OSC] Helper did not accept the shared memory transport, staying on UDP");
+                closeSharedMemory();
+            }
+        }
+
+        forEachClient([](const ClientEntry& entry) { entry.client->oscTick(); });
+    }
+
+    forEachClient([](const ClientEntry& entry) { entry.client->telemetryTick(); });
+
+    // one bundle per tick for the updates of every panner
+    flush();
+}
+
+void PannerOSCHub::handleAsyncUpdate()
+{
+    std::vector<juce::OSCMessage> messages;
+    {
+        const RealtimeGuard::ScopedLock sl(lock);
+        if (sharedMemory == nullptr)
+            return;
+        messages = sharedMemory->takeReceivedMessages();
+    }
+
+    for (const auto& msg : messages)
+    {
+        oscMessageReceived(msg);
+    }
+}
+
+void PannerOSCHub::flush()
+{
+    const RealtimeGuard::ScopedLock sl(lock);
+    if (pending.empty())
+        return;
+
+    // no syscall per message through the ring, whatever doesn't fit goes out over UDP
+    size_t first = 0;
+    if (sharedMemoryActive)
+    {
+        while (first < pending.size() && sharedMemory->send(pending[first].message))
+            first++;
+
+        if (first < pending.size())
+            closeSharedMemory();
+    }
+
+    if (senderConnected)
+    {
+        bool sendFailed = false;
+        juce::OSCBundle bundle;
+        for (size_t i = first; i < pending.size(); i++)
+        {
+            bundle.addElement(pending[i].message);
+            if (bundle.size() == maxMessagesPerBundle || i == pending.size() - 1)
+            {
+                // Add extra protection around the send operation
+                try
+                {
+                    if (!sender.send(bundle))
+                        sendFailed = true;
+                }
+                catch (...)
+                {
+                    sendFailed = true;
+                }
+                bundle = juce::OSCBundle();
+            }
+        }
+
+        if (sendFailed)
+        {
+            connected = false;
+            keepAlive.failed(juce::Time::getMillisecondCounter());
+        }
+    }
+    pending.clear();
+}
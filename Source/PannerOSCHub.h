@@ -0,0 +1,161 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "HelperKeepAlive.h"
+#include "SharedMemoryTransport.h"
+
+/// The one OSC socket pair of the plugin process, shared by every panner instance through a
+/// `juce::SharedResourcePointer`.
+///
+/// The hub reads settings.json once, binds a single receiver port, registers it with the
+/// m1-system-helper and runs the only periodic timer the panners need. The timer runs at the
+/// telemetry rate (`telemetryRate` in settings.json, 60 Hz by default) and the slower housekeeping
+/// tick is derived from it. Instances attach as clients and get a panner ID that is unique in the
+/// process, counted up from a random start above `minPannerId` so it neither repeats across processes
+/// nor looks like an ordinary int argument. Messages on the addresses listed in
+/// `isAddressedToPanner()` carry a panner ID first and only reach that client, everything else
+/// (monitor settings, channel configs) goes to all of them. The clients are called
+/// without the hub's lock held and the connection state is atomic, so host callbacks never run under a
+/// process-wide lock and the editors never wait for a tick. Outbound messages are
+/// queued and sent as OSC bundles on the shared tick, a newer message from the same client to the
+/// same address replaces the queued one. Through the shared memory rings they go out right away.
+///
+/// After registering, the hub offers the helper a SharedMemoryTransport (`/m1-shm-offer`). Once the
+/// helper answers `/m1-shm-accept` through it, all traffic in both directions goes through the rings.
+/// The hub stays on UDP if the helper doesn't answer, and falls back to it when a ring is full or the
+/// connection times out. `"sharedMemoryTransport": false` in settings.json disables the offer.
+///
+/// Pings from the helper get one `/m1-status-plugin` per process, sent with the next bundle (right
+/// away through the rings). A helper advertises what it supports with an optional capability bit
+/// mask in its `/m1-ping`, e.g. `helperCapabilityPannerDelta` for delta encoded telemetry. Registration is retried with exponential backoff while the helper is
+/// unreachable and it counts as gone after `livenessWindowMs` (settings.json, 10 s by default).
+class PannerOSCHub : private juce::OSCReceiver,
+                     private juce::OSCReceiver::Listener<juce::OSCReceiver::MessageLoopCallback>,
+                     private juce::Timer,
+                     private juce::AsyncUpdater
+{
+public:
+    class Client
+    {
+    public:
+        virtual ~Client() = default;
+
+        /// A message for this panner or for every panner, called on the message thread
+        virtual void oscMessageReceived(const juce::OSCMessage& msg) = 0;
+
+        /// Called every housekeeping interval on the message thread, before the queued messages are sent
+        virtual void oscTick() = 0;
+
+        /// Called at the telemetry rate on the message thread, before the queued messages are sent
+        virtual void telemetryTick() = 0;
+    };
+
+    static constexpr int housekeepingIntervalMs = 50;
+    static constexpr int defaultTelemetryRateHz = 60;
+    static constexpr int maxTelemetryRateHz = 120;
+    static constexpr int maxMessagesPerBundle = 64; // keeps a bundle well below the UDP datagram limit
+    static constexpr juce::uint32 sharedMemoryOfferTimeoutMs = 1000;
+    static constexpr int statusReplyId = 0; // queue key of the ping reply, below every panner ID
+    static constexpr int minPannerId = 1 << 20;
+    static constexpr int pannerIdRange = 1 << 29;
+    static constexpr int helperCapabilityPannerDelta = 1; // `/m1-ping` capability bit, the helper understands `/panner-delta`
+
+    PannerOSCHub();
+    ~PannerOSCHub() override;
+
+    /// Attaches a client and returns its panner ID
+    int addClient(Client* client);
+
+    /// True for the inbound addresses whose first argument is the ID of the one panner they are for
+    static bool isAddressedToPanner(const juce::OSCAddressPattern& address);
+
+    /// Message thread, the client is never called again once this returns
+    void removeClient(Client* client);
+
+    /// Binds the receiver and connects to the helper on `helperPort` if that has not happened yet,
+    /// returns false if no receiver port could be bound
+    bool start(int helperPort);
+
+    bool hasSettingsFile() const { return settingsFileFound; }
+
+    /// Changes how often telemetry is collected and bundles are sent, in Hz. Message thread only.
+    void setTelemetryRate(int rateHz);
+    int getTelemetryRate() const { return telemetryRateHz.load(); }
+
+    /// How long the helper may stay silent before it counts as gone, in milliseconds
+    void setLivenessWindow(int windowMs);
+
+    // Never lock, the editors poll these while they render
+    bool isReceiving() const { return receiving.load(); }
+    bool isConnected() const { return connected.load(); }
+    bool isUsingSharedMemory() const { return sharedMemoryActive.load(); }
+
+    /// True once the connected helper advertised `helperCapabilityPannerDelta`
+    bool helperAcceptsTelemetryDeltas() const { return connected.load() && (helperCapabilities.load() & helperCapabilityPannerDelta) != 0; }
+    int getPort() const { return port.load(); }
+
+    /// Queues a message for the next bundle or sends it through the rings right away, returns false
+    /// while the helper is not connected
+    bool queue(int pannerId, const juce::OSCMessage& msg);
+
+    /// Queues a message even while disconnected, for the goodbye of a panner that is going away
+    void queueRegardless(int pannerId, const juce::OSCMessage& msg);
+
+private:
+    void oscMessageReceived(const juce::OSCMessage& msg) override;
+    void timerCallback() override;
+    void handleAsyncUpdate() override;
+
+    bool bindReceiver();
+    void connectToHelper();
+    void offerSharedMemory();
+    void closeSharedMemory();
+    bool sendNow(const juce::OSCMessage& msg);
+    void flush();
+
+    /// Calls `callback` for every client without holding the lock, the clients call back into the host
+    template <typename Callback>
+    void forEachClient(Callback&& callback);
+
+    struct ClientEntry
+    {
+        Client* client;
+        int pannerId;
+    };
+
+    struct QueuedMessage
+    {
+        int pannerId;
+        juce::OSCMessage message;
+    };
+
+    juce::CriticalSection lock; // never taken on the audio thread, RealtimeGuard counts it if it is
+    juce::OSCSender sender;
+    std::vector<ClientEntry> clients;
+    std::atomic<juce::uint32> clientsRemoved { 0 }; // lets a dispatch skip clients detached meanwhile
+    std::vector<QueuedMessage> pending;
+    int nextPannerId = minPannerId;
+
+    bool settingsFileFound = false;
+    int helperPort = 0;
+    std::atomic<int> port { 0 };
+    std::atomic<bool> receiving { false };
+    bool senderConnected = false;
+    std::atomic<bool> connected { false }; // registered with the helper and heard from it within the timeout
+    std::atomic<int> helperCapabilities { 0 }; // from the last ping, cleared whenever the connection is lost
+    HelperKeepAlive keepAlive;
+    std::atomic<int> telemetryRateHz { defaultTelemetryRateHz };
+    juce::uint32 lastHousekeepingTime = 0;
+
+    std::unique_ptr<SharedMemoryTransport> sharedMemory; // offered to the helper, in use once accepted
+    bool sharedMemoryEnabled = true;
+    std::atomic<bool> sharedMemoryActive { false };
+    juce::uint32 sharedMemoryOfferTime = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PannerOSCHub)
+};
@@ -0,0 +1,111 @@
+#include "PannerTelemetry.h"
+
+namespace
+{
+bool areColoursEqual(const juce::OSCColour& lhs, const juce::OSCColour& rhs)
+{
+    return lhs.toInt32() == rhs.toInt32();
+}
+}
+
+juce::OSCMessage PannerTelemetry::createKeyframe(int pannerId, const State& state)
+{
+    juce::OSCMessage m = juce::OSCMessage(juce::OSCAddressPattern("/panner-settings"));
+    m.addInt32(pannerId); // [msg[0]]: used for id
+    m.addInt32(state.state); // [msg[1]]: used for panner interactive state
+    m.addString(state.displayName); // [msg[2]]: string for track name (when available)
+    m.addColour(state.colour); // [msg[3]]: hex for track color (when available)
+    m.addInt32(state.inputMode); // [msg[4]]: int of enum `Mach1EncodeInputModeType`
+    m.addFloat32(state.azimuth); // [msg[5]]: expected degrees -180->180
+    m.addFloat32(state.elevation); // [msg[6]]: expected degrees -90->90
+    m.addFloat32(state.diverge); // [msg[7]]: expected normalized -100->100
+    m.addFloat32(state.gain); // [msg[8]]: expected as dB value -90->24
+    m.addInt32(state.pannerMode); // [msg[9]]: int of enum `Mach1EncodePannerModeType`
+    m.addInt32(state.gainCompensation); // [msg[10]]: bool
+    if (state.inputMode == stereoInputMode)
+    {
+        // send stereo parameters
+        m.addInt32(state.stereoAutoOrbit); // [msg[11]]: bool
+        m.addFloat32(state.stereoAzimuth); // [msg[12]]: expected degrees -180->180
+        m.addFloat32(state.stereoSpread); // [msg[13]]: expected normalized -100->100
+    }
+    return m;
+}
+
+bool PannerTelemetry::isKeyframeDue(const State& current, juce::uint32 nowMs) const
+{
+    // a different input mode adds or removes the stereo fields
+    return keyframeRequested || !hasSent
+        || current.inputMode != lastSent.inputMode
+        || nowMs - lastKeyframeTime >= keyframeIntervalMs;
+}
+
+std::optional<juce::OSCMessage> PannerTelemetry::createUpdate(int pannerId, const State& current, juce::uint32 nowMs, bool& isKeyframe) const
+{
+    isKeyframe = isKeyframeDue(current, nowMs);
+    if (isKeyframe)
+        return createKeyframe(pannerId, current);
+
+    juce::OSCMessage message = juce::OSCMessage(juce::OSCAddressPattern("/panner-delta"));
+    message.addInt32(pannerId);
+
+    auto addInt = [&message](Field field, int value) { message.addInt32((juce::int32)field); message.addInt32(value); };
+    auto addFloat = [&message](Field field, float value) { message.addInt32((juce::int32)field); message.addFloat32(value); };
+
+    if (current.state != lastSent.state)
+        addInt(state, current.state);
+    if (current.displayName != lastSent.displayName)
+    {
+        message.addInt32((juce::int32)displayName);
+        message.addString(current.displayName);
+    }
+    if (!areColoursEqual(current.colour, lastSent.colour))
+    {
+        message.addInt32((juce::int32)colour);
+        message.addColour(current.colour);
+    }
+    if (current.azimuth != lastSent.azimuth)
+        addFloat(azimuth, current.azimuth);
+    if (current.elevation != lastSent.elevation)
+        addFloat(elevation, current.elevation);
+    if (current.diverge != lastSent.diverge)
+        addFloat(diverge, current.diverge);
+    if (current.gain != lastSent.gain)
+        addFloat(gain, current.gain);
+    if (current.pannerMode != lastSent.pannerMode)
+        addInt(pannerMode, current.pannerMode);
+    if (current.gainCompensation != lastSent.gainCompensation)
+        addInt(gainCompensation, current.gainCompensation);
+    if (current.inputMode == stereoInputMode)
+    {
+        if (current.stereoAutoOrbit != lastSent.stereoAutoOrbit)
+            addInt(stereoAutoOrbit, current.stereoAutoOrbit);
+        if (current.stereoAzimuth != lastSent.stereoAzimuth)
+            addFloat(stereoAzimuth, current.stereoAzimuth);
+        if (current.stereoSpread != lastSent.stereoSpread)
+            addFloat(stereoSpread, current.stereoSpread);
+    }
+
+    // only the panner ID, nothing changed
+    if (message.size() == 1)
+        return std::nullopt;
+
+    // a helper that doesn't know deltas gets the whole settings for every change
+    if (!deltasEnabled)
+    {
+        isKeyframe = true;
+        return createKeyframe(pannerId, current);
+    }
+    return message;
+}
+
+void PannerTelemetry::markSent(const State& sent, bool wasKeyframe, juce::uint32 nowMs)
+{
+    lastSent = sent;
+    hasSent = true;
+    if (wasKeyframe)
+    {
+        keyframeRequested = false;
+        lastKeyframeTime = nowMs;
+    }
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+#include <optional>
+
+/// Builds the telemetry stream one panner sends to the helper.
+///
+/// A keyframe is the full `/panner-settings` message. In between, `/panner-delta` only carries the
+/// fields that changed since the last state that was handed to the hub, as (field, value) argument pairs
+/// where the field is the argument index the value has in `/panner-settings`. A keyframe is sent
+/// periodically so the helper resyncs after a dropped datagram, and whenever the field layout changes.
+/// Deltas are only sent once the helper advertised that it understands them, until then every change
+/// goes out as a keyframe.
+class PannerTelemetry
+{
+public:
+    /// Argument index of every field in `/panner-settings`, index 0 is the panner ID
+    enum Field
+    {
+        state = 1,
+        displayName,
+        colour,
+        inputMode,
+        azimuth,
+        elevation,
+        diverge,
+        gain,
+        pannerMode,
+        gainCompensation,
+        stereoAutoOrbit, // stereo fields are only part of the stream for stereo input
+        stereoAzimuth,
+        stereoSpread,
+        numFields
+    };
+
+    struct State
+    {
+        int state = 0;
+        juce::String displayName;
+        juce::OSCColour colour = { 0, 0, 0, 255 };
+        int inputMode = 0;
+        float azimuth = 0.0f; // degrees -180->180
+        float elevation = 0.0f; // degrees -90->90
+        float diverge = 0.0f; // normalized -100->100
+        float gain = 0.0f; // dB -90->24
+        int pannerMode = 0;
+        bool gainCompensation = false;
+        bool stereoAutoOrbit = false;
+        float stereoAzimuth = 0.0f; // degrees -180->180
+        float stereoSpread = 0.0f; // normalized -100->100
+    };
+
+    static constexpr juce::uint32 keyframeIntervalMs = 2000;
+    static constexpr int stereoInputMode = 1;
+
+    /// Whether the helper understands `/panner-delta`, off until it says so
+    void setDeltasEnabled(bool enabled) noexcept { deltasEnabled = enabled; }
+
+    /// The keyframe or delta that brings the helper to `current`, nothing if no field changed and no
+    /// keyframe is due. `isKeyframe` tells which of the two it is.
+    std::optional<juce::OSCMessage> createUpdate(int pannerId, const State& current, juce::uint32 nowMs, bool& isKeyframe) const;
+
+    /// Records `sent` as the state the helper knows, call once the update was queued
+    void markSent(const State& sent, bool wasKeyframe, juce::uint32 nowMs);
+
+    /// Makes the next update a keyframe, e.g. after the helper connection was re-established
+    void requestKeyframe() noexcept { keyframeRequested = true; }
+
+    bool isKeyframeDue(const State& current, juce::uint32 nowMs) const;
+
+    /// The full `/panner-settings` message for `state`
+    static juce::OSCMessage createKeyframe(int pannerId, const State& state);
+
+private:
+    State lastSent;
+    bool hasSent = false;
+    bool keyframeRequested = true;
+    bool deltasEnabled = false;
+    juce::uint32 lastKeyframeTime = 0;
+};
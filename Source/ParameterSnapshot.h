@@ -0,0 +1,61 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "SnapshotBuffer.h"
+#include "TypesForDataExchange.h"
+
+/// The panner parameters the audio and encoder threads work from, published as one coherent value.
+///
+/// `PannerSettings` stays the editor's working copy, everything off the message thread reads an
+/// instance of this from `SnapshotBuffer<ParameterSnapshot>` instead of individual settings fields.
+struct ParameterSnapshot
+{
+    float azimuth = 0.0f;
+    float elevation = 0.0f;
+    float diverge = 50.0f;
+    float gain = 0.0f; // dB
+    float stereoOrbitAzimuth = 0.0f;
+    float stereoSpread = 50.0f;
+    float stereoInputBalance = 0.0f;
+    int inputMode = 0;
+    int inputChannelsCount = 1;
+    int outputMode = 0;
+    int monitorMode = 0;
+    bool autoOrbit = true;
+    bool isotropicMode = true;
+    bool equalpowerMode = true;
+    bool gainCompensationMode = true;
+    bool lockOutputLayout = false;
+    bool itdActive = false;
+    float delayTime = 600.0f; // microseconds
+    float delayDistance = 1.0f;
+
+    /// Everything the settings currently hold, used to seed the buffer
+    static ParameterSnapshot fromSettings(PannerSettings& settings, const MixerSettings& monitor)
+    {
+        ParameterSnapshot snapshot;
+        snapshot.azimuth = settings.azimuth;
+        snapshot.elevation = settings.elevation;
+        snapshot.diverge = settings.diverge;
+        snapshot.gain = settings.gain;
+        snapshot.stereoOrbitAzimuth = settings.stereoOrbitAzimuth;
+        snapshot.stereoSpread = settings.stereoSpread;
+        snapshot.stereoInputBalance = settings.stereoInputBalance;
+        snapshot.inputMode = static_cast<int>(settings.m1Encode.getInputMode());
+        snapshot.inputChannelsCount = settings.m1Encode.getInputChannelsCount();
+        snapshot.outputMode = static_cast<int>(settings.m1Encode.getOutputMode());
+        snapshot.monitorMode = monitor.monitor_mode;
+        snapshot.autoOrbit = settings.autoOrbit;
+        snapshot.isotropicMode = settings.isotropicMode;
+        snapshot.equalpowerMode = settings.equalpowerMode;
+        snapshot.gainCompensationMode = settings.gainCompensationMode;
+        snapshot.lockOutputLayout = settings.lockOutputLayout;
+#ifdef ITD_PARAMETERS
+        snapshot.itdActive = settings.itdActive;
+        snapshot.delayTime = (float)settings.delayTime;
+        snapshot.delayDistance = settings.delayDistance;
+#endif
+        return snapshot;
+    }
+};
@@ -8,6 +8,7 @@
 
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
+#include "MixingKernels.h"
 
 // Platform-specific includes for process ID.
 #if JUCE_WINDOWS
@@ -36,6 +37,51 @@ bool areUiReticleSnapshotStatesEqual(const M1PannerAudioProcessor::UiReticleSnap
         && lhs.outputMode == rhs.outputMode;
 }
 
+Mach1EncodePannerMode getPannerMode(bool isotropicMode, bool equalpowerMode)
+{
+    if (isotropicMode)
+    {
+        return equalpowerMode ? Mach1EncodePannerMode::IsotropicEqualPower : Mach1EncodePannerMode::IsotropicLinear;
+    }
+    return Mach1EncodePannerMode::PeriphonicLinear;
+}
+
+// Monitor mode 1 collapses the diverge and compensates its loudness through the gain
+void applyMonitorModeToPosition(int monitorMode, float& diverge, float& gain)
+{
+    if (monitorMode == 1)
+    {
+        const float absDiverge = fabsf((diverge - -100.0f) / (100.0f - -100.0f));
+        gain -= absDiverge * 6.0f;
+        diverge = 0.0f;
+    }
+}
+
+CoefficientTable::Key getCoefficientTableKey(const M1PannerAudioProcessor::UiReticleSnapshotState& state)
+{
+    CoefficientTable::Key key;
+    key.inputMode = state.inputMode;
+    key.outputMode = state.outputMode;
+    key.pannerMode = static_cast<int>(getPannerMode(state.isotropicMode, state.equalpowerMode));
+    key.autoOrbit = state.autoOrbit;
+    key.gainCompensation = state.gainCompensationMode;
+    return key;
+}
+
+// Per-input gains folded into the mixing matrix, the stereo input balance pans the two inputs against each other
+void getInputTrims(int inputMode, float stereoInputBalance, CoefficientFrame::InputTrims& trims)
+{
+    trims.fill(1.0f);
+
+    // Only apply stereo input balance if it's not at default (0)
+    if (inputMode == Mach1EncodeInputMode::Stereo && std::abs(stereoInputBalance) > 0.001f)
+    {
+        float p = juce::MathConstants<float>::pi * (stereoInputBalance + 1) / 4;
+        trims[0] = std::cos(p); // gain for Left
+        trims[1] = std::sin(p); // gain for Right
+    }
+}
+
 }
 
 /*
@@ -91,7 +137,14 @@ M1PannerAudioProcessor::M1PannerAudioProcessor()
           std::make_unique<juce::AudioParameterFloat>(juce::ParameterID(paramDelayTime, 1), TRANS("Delay Time (max)"), juce::NormalisableRange<float>(0.0f, 10000.0f, 1.0f), pannerSettings.delayTime, "", juce::AudioProcessorParameter::genericParameter, [](float v, int) { return juce::String(v, 1) + "μS"; }, [](const juce::String& t) { return t.dropLastCharacters(1).getFloatValue(); }),
           std::make_unique<juce::AudioParameterFloat>(juce::ParameterID(paramDelayDistance, 1), TRANS("Delay Distance"), juce::NormalisableRange<float>(0.0f, 10000.0f, 0.01f), pannerSettings.delayDistance, "", juce::AudioProcessorParameter::genericParameter, [](float v, int) { return juce::String(v, 1) + ""; }, [](const juce::String& t) { return t.dropLastCharacters(1).getFloatValue(); }),
 #endif
-                                                                      })
+                                                                      }),
+      coefficientProducer([this](Mach1Encode<float>& encode, CoefficientTable::Key& tableKey, CoefficientFrame::InputTrims& inputTrims) {
+          publishParameterSnapshotIfNeeded();
+          const auto state = getUiReticleSnapshotState();
+          applyStateToEncode(encode, state);
+          tableKey = getCoefficientTableKey(state);
+          getInputTrims(state.inputMode, state.stereoInputBalance, inputTrims);
+      })
 {
     parameters.addParameterListener(paramAzimuth, this);
     parameters.addParameterListener(paramElevation, this);
@@ -114,21 +167,48 @@ M1PannerAudioProcessor::M1PannerAudioProcessor()
     parameters.addParameterListener(paramDelayDistance, this);
 #endif
 
+    rawParameterValues.azimuth = parameters.getRawParameterValue(paramAzimuth);
+    rawParameterValues.elevation = parameters.getRawParameterValue(paramElevation);
+    rawParameterValues.diverge = parameters.getRawParameterValue(paramDiverge);
+    rawParameterValues.gain = parameters.getRawParameterValue(paramGain);
+    rawParameterValues.autoOrbit = parameters.getRawParameterValue(paramAutoOrbit);
+    rawParameterValues.stereoOrbitAzimuth = parameters.getRawParameterValue(paramStereoOrbitAzimuth);
+    rawParameterValues.stereoSpread = parameters.getRawParameterValue(paramStereoSpread);
+    rawParameterValues.stereoInputBalance = parameters.getRawParameterValue(paramStereoInputBalance);
+    rawParameterValues.isotropicMode = parameters.getRawParameterValue(paramIsotropicEncodeMode);
+    rawParameterValues.equalpowerMode = parameters.getRawParameterValue(paramEqualPowerEncodeMode);
+    rawParameterValues.gainCompensationMode = parameters.getRawParameterValue(paramGainCompensationMode);
+#ifdef ITD_PARAMETERS
+    rawParameterValues.itdActive = parameters.getRawParameterValue(paramITDActive);
+    rawParameterValues.delayTime = parameters.getRawParameterValue(paramDelayTime);
+    rawParameterValues.delayDistance = parameters.getRawParameterValue(paramDelayDistance);
+#endif
+
 #ifndef CUSTOM_CHANNEL_LAYOUT
     requestedInputMode.store(static_cast<int>(pannerSettings.m1Encode.getInputMode()));
     requestedOutputMode.store(static_cast<int>(pannerSettings.m1Encode.getOutputMode()));
 #endif
 
+    // seed what the audio and encoder threads read with the defaults
+    const auto initialSnapshot = ParameterSnapshot::fromSettings(pannerSettings, monitorSettings);
+    parameterSnapshot.update([&initialSnapshot](ParameterSnapshot& snapshot) { snapshot = initialSnapshot; });
+
     // Setup osc and listener
     pannerOSC = std::make_unique<PannerOSC>(this);
     pannerOSC->AddListener([&](juce::OSCMessage msg) {
         if (msg.getAddressPattern() == "/monitor-settings")
         {
+            const auto receivedMs = MonitorOrientationFeed::now();
             if (msg.size() > 0)
             {
                 // Capturing monitor mode
                 int mode = msg[0].getInt32();
                 monitorSettings.monitor_mode = mode;
+                if (parameterSnapshot.read().monitorMode != mode)
+                {
+                    parameterSnapshot.update([mode](ParameterSnapshot& snapshot) { snapshot.monitorMode = mode; });
+                    coefficientProducer.requestUpdate(); // the monitor mode changes the position the encoder is fed
+                }
             }
             if (msg.size() >= 2)
             {
@@ -149,13 +229,34 @@ M1PannerAudioProcessor::M1PannerAudioProcessor()
                     DBG("[OSC] Recieved msg | Mode: " + std::to_string(msg[0].getInt32()) + ", Y: " + std::to_string(msg[1].getFloat32()) + ", P: " + std::to_string(msg[2].getFloat32()));
                 }
             }
+            if (msg.size() >= 4 && msg[3].isFloat32())
+            {
+                // Capturing Monitor's Roll
+                monitorSettings.roll = msg[3].getFloat32();
+            }
+            if (msg.size() >= 3 && msg[1].isFloat32() && msg[2].isFloat32())
+            {
+                // optional helper send time in microseconds of the monotonic clock, for the latency statistics
+                std::optional<juce::uint32> sentUs;
+                if (msg.size() >= 5 && msg[4].isInt32())
+                    sentUs = (juce::uint32)msg[4].getInt32();
+                monitorOrientation.push({ monitorSettings.yaw, monitorSettings.pitch, monitorSettings.roll }, receivedMs, sentUs);
+
+                const auto stats = monitorOrientation.getStatistics();
+                if (stats.numSamples % 1000 == 0)
+                {
+                    DBG("[OSC] Monitor orientation | interval: " + juce::String(stats.meanIntervalMs, 2) + " ms, jitter: " + juce::String(stats.jitterMs, 2)
+                        + " ms, max: " + juce::String(stats.maxIntervalMs, 2) + " ms, latency: " + (stats.hasLatency ? juce::String(stats.meanLatencyMs, 3) + " ms" : juce::String("n/a")));
+                }
+            }
         }
         else if (msg.getAddressPattern() == "/m1-channel-config")
         {
             DBG("[OSC] Recieved msg | Channel Config: " + std::to_string(msg[0].getInt32()));
             // Capturing monitor active state
             int channel_count = msg[0].getInt32();
-            if (!pannerSettings.lockOutputLayout && channel_count != pannerSettings.m1Encode.getInputChannelsCount()) // got a request for a different config
+            const auto params = parameterSnapshot.read();
+            if (!params.lockOutputLayout && channel_count != params.inputChannelsCount) // got a request for a different config
             {
                 if (channel_count == 4)
                 {
@@ -191,8 +292,19 @@ M1PannerAudioProcessor::M1PannerAudioProcessor()
         osc_colour.alpha = 255;
     }
 
-    // pannerOSC update timer loop
-    startTimer(50);
+    // pannerOSC update loop, one shared tick for every panner in the process
+    pannerOSC->onTick = [this] { timerCallback(); };
+    pannerOSC->telemetrySource = [this] { return getTelemetryState(); };
+
+#ifdef COEFFICIENT_LUT
+    // Position changes are evaluated from a precomputed table at control rate, `M1_LUT_RESOLUTION`
+    // (e.g. "144x37x21") overrides its grid for benchmarking
+    setCoefficientTableResolution(CoefficientTable::Resolution::fromString(juce::SystemStats::getEnvironmentVariable("M1_LUT_RESOLUTION", {})));
+#endif
+
+    // Mach1Encode point generation runs on its own thread
+    coefficientProducer.start();
+    coefficientProducer.requestUpdate();
 
     // print build time for debug
     juce::String date(__DATE__);
@@ -202,8 +314,10 @@ M1PannerAudioProcessor::M1PannerAudioProcessor()
 
 M1PannerAudioProcessor::~M1PannerAudioProcessor()
 {
+    // before any member is destroyed, the producer thread calls back into this processor
+    coefficientProducer.stop();
     pannerSettings.state = -1;
-    stopTimer();
+    pannerOSC.reset(); // detaches from the shared tick and says goodbye to the helper
 }
 
 //==============================================================================
@@ -411,13 +525,14 @@ void M1PannerAudioProcessor::applyPendingModeChange()
         pannerSettings.m1Encode.setOutputMode(requestedOutput);
 
     createLayout();
-    pendingPannerSettingsSend.store(true);
+    pendingTelemetryKeyframe.store(true);
 #endif
 }
 
 void M1PannerAudioProcessor::applyPendingStereoParameterReset()
 {
-    if (!pendingStereoParameterReset.exchange(false))
+    // the flag stays set until the parameters hold the zeros, publishParameterSnapshotIfNeeded() zeroes them meanwhile
+    if (!pendingStereoParameterReset.load())
         return;
 
     if (!pannerSettings.autoOrbit)
@@ -430,6 +545,45 @@ void M1PannerAudioProcessor::applyPendingStereoParameterReset()
         stereoSpreadParam->setValueNotifyingHost(stereoSpreadParam->convertTo0to1(0.0f));
         stereoBalanceParam->setValueNotifyingHost(stereoBalanceParam->convertTo0to1(0.0f));
     }
+    pendingStereoParameterReset.store(false);
+}
+
+void M1PannerAudioProcessor::publishParameterSnapshotIfNeeded()
+{
+    // clear the flag before reading the parameters so a change made meanwhile is published by the next call
+    if (!parameterSnapshotDirty.exchange(false))
+        return;
+
+    const auto& raw = rawParameterValues;
+    const bool clearStereoParameters = pendingStereoParameterReset.load();
+
+    parameterSnapshot.update([&raw, clearStereoParameters](ParameterSnapshot& snapshot) {
+        snapshot.azimuth = raw.azimuth->load();
+        snapshot.elevation = raw.elevation->load();
+        snapshot.diverge = raw.diverge->load();
+        snapshot.gain = raw.gain->load();
+        snapshot.stereoOrbitAzimuth = raw.stereoOrbitAzimuth->load();
+        snapshot.stereoSpread = raw.stereoSpread->load();
+        snapshot.stereoInputBalance = raw.stereoInputBalance->load();
+        snapshot.isotropicMode = raw.isotropicMode->load() >= 0.5f;
+        snapshot.equalpowerMode = raw.equalpowerMode->load() >= 0.5f;
+        snapshot.gainCompensationMode = raw.gainCompensationMode->load() >= 0.5f;
+#ifdef ITD_PARAMETERS
+        snapshot.itdActive = raw.itdActive->load() >= 0.5f;
+        snapshot.delayTime = raw.delayTime->load();
+        snapshot.delayDistance = raw.delayDistance->load();
+#endif
+
+        // auto orbit only follows the parameter in stereo mode, switching it off resets the stereo parameters
+        if (snapshot.inputMode == Mach1EncodeInputMode::Stereo)
+            snapshot.autoOrbit = raw.autoOrbit->load() >= 0.5f;
+        if (!snapshot.autoOrbit && clearStereoParameters)
+        {
+            snapshot.stereoOrbitAzimuth = 0.0f;
+            snapshot.stereoSpread = 0.0f;
+            snapshot.stereoInputBalance = 0.0f;
+        }
+    });
 }
 
 //==============================================================================
@@ -444,6 +598,13 @@ void M1PannerAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBloc
     // can still be used to calculate coeffs even in STREAMING_PANNER_PLUGIN mode
     processorSampleRate = sampleRate;
 
+    // Pick the DSP kernels for this CPU (once per process) and size the mixer for the new sample rate
+    DspKernels::selectForThisMachine();
+    for (auto& engine : mixingEngines)
+    {
+        engine.prepare(sampleRate, pannerSettings.m1Encode.getInputChannelsCount(), pannerSettings.m1Encode.getOutputChannelsCount());
+    }
+
     if (pannerSettings.m1Encode.getOutputChannelsCount() != getMainBusNumOutputChannels())
     {
         bool channel_io_error = -1;
@@ -453,23 +614,35 @@ void M1PannerAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBloc
     // Checks if output bus is non DISCRETE layout and fixes host specific channel ordering issues
     fillChannelOrderArray(pannerSettings.m1Encode.getOutputChannelsCount());
 
-#ifdef ITD_PARAMETERS
-    mSampleRate = sampleRate;
-    mDelayTimeSmoother.reset(samplesPerBlock);
-    mDelayTimeSmoother.setValue(0);
+    // processBlock() is not running, so the configuration is taken over without a crossfade
+    publishChannelConfiguration();
+    channelConfigurations.acquireLatest();
+    activeConfiguration = channelConfigurations.getReadBuffer();
+    mixerFadingOut = false;
+
+    // Preallocate everything processBlock() touches for the largest supported channel counts
+    outputScratch.setSize(MixingEngine::maxInputChannels, samplesPerBlock, false, true, false);
+    outputMeters.prepare(sampleRate);
+    silenceDetector.prepare(sampleRate);
 
-    ring.reset(new RingBuffer(pannerSettings..getOutputChannelsCount(), 64 * sampleRate));
-    ring->clear();
+#if M1_MIXER_BENCHMARK
+    juce::Logger::writeToLog("[Mix] Kernel benchmark, " + juce::String(samplesPerBlock) + " samples x 1000 blocks\n" + MixingKernels::runBenchmark(sampleRate, samplesPerBlock, 1000));
+#endif
 
-    // sample buffer for 2 seconds + MAX_NUM_CHANNELS buffers safety
-    mDelayBuffer.setSize(pannerSettings..getOutputChannelsCount(), (float)pannerSettings.m1Encode.getOutputChannelsCount() * (samplesPerBlock + sampleRate), false, false);
-    mDelayBuffer.clear();
-    mExpectedReadPos = -1;
+#ifdef ITD_PARAMETERS
+    // delay memory is only allocated while ITD is on, otherwise timerCallback() does it once ITD is switched on
+    itdProcessor.prepare(sampleRate, samplesPerBlock);
+    publishParameterSnapshotIfNeeded();
+    if (parameterSnapshot.read().itdActive)
+        itdProcessor.allocate();
+    pendingITDStateChange.store(true);
 #endif
 
     // Initialize OSC if not already done
     if (!pannerOSC) {
         pannerOSC = std::make_unique<PannerOSC>(this);
+        pannerOSC->onTick = [this] { timerCallback(); };
+        pannerOSC->telemetrySource = [this] { return getTelemetryState(); };
         if (!pannerOSC->init(9001)) {
             Mach1::AlertData alert;
             alert.title = "Initialization Warning";
@@ -484,26 +657,21 @@ void M1PannerAudioProcessor::releaseResources()
 {
     // When playback stops, you can use this as an opportunity to free up any
     // spare memory, etc.
+#ifdef ITD_PARAMETERS
+    itdProcessor.release();
+#endif
 }
 
 void M1PannerAudioProcessor::parameterChanged(const juce::String& parameterID, float newValue)
 {
     // Expects non-normalised values
 
-    needToUpdateM1EncodePoints.store(true); // need to call to update the m1encode obj for new point counts
     uiReticleSnapshotDirty.store(true);
 
     if (parameterID == paramAzimuth)
     {
         // Update internal state
         pannerSettings.azimuth = newValue;
-
-        // Only do coordinate conversion if azimuth is NOT currently owned by a UI control
-        if (!azimuthOwnedByUI.load())
-        {
-            convertRCtoXYRaw(pannerSettings.azimuth, pannerSettings.diverge,
-                            pannerSettings.x, pannerSettings.y);
-        }
     }
     else if (parameterID == paramElevation)
     {
@@ -514,12 +682,6 @@ void M1PannerAudioProcessor::parameterChanged(const juce::String& parameterID, f
     {
         // Update internal state
         pannerSettings.diverge = newValue;
-
-        // Only do coordinate conversion if diverge is NOT currently owned by a UI control
-        if (!divergeOwnedByUI.load())
-        {
-            convertRCtoXYRaw(pannerSettings.azimuth, pannerSettings.diverge, pannerSettings.x, pannerSettings.y);
-        }
     }
     else if (parameterID == paramGain)
     {
@@ -589,6 +751,7 @@ void M1PannerAudioProcessor::parameterChanged(const juce::String& parameterID, f
     else if (parameterID == paramITDActive)
     {
         pannerSettings.itdActive = (bool)newValue;
+        pendingITDStateChange.store(true); // allocation and latency are handled on the message thread
     }
     else if (parameterID == paramDelayTime)
     {
@@ -603,8 +766,16 @@ void M1PannerAudioProcessor::parameterChanged(const juce::String& parameterID, f
     {
         pannerSettings.lockOutputLayout = (bool)newValue;
         lockOutputLayout = (bool)newValue;
+        // not a host parameter, only ever set from the message thread
+        parameterSnapshot.update([newValue](ParameterSnapshot& snapshot) { snapshot.lockOutputLayout = (bool)newValue; });
     }
-    pendingPannerSettingsSend.store(true);
+    // this may run on the audio thread, the snapshot is rebuilt from the parameters by the encoder or message thread
+    parameterSnapshotDirty.store(true);
+    coefficientProducer.requestUpdate(); // regenerate the m1encode points off the audio thread
+
+    // edits in the editor reach the helper at once, host automation with the next telemetry tick
+    if (pannerOSC != nullptr && juce::MessageManager::existsAndIsCurrentThread())
+        pannerOSC->sendTelemetryNow();
 }
 
 #ifndef CUSTOM_CHANNEL_LAYOUT
@@ -716,9 +887,9 @@ void M1PannerAudioProcessor::fillChannelOrderArray(int numM1OutputChannels)
     int numHostOutputChannels = getBus(false, 0)->getNumberOfChannels();
 
     // sets the maximum channels of the current selected m1 output layout
+    numM1OutputChannels = juce::jmin(numM1OutputChannels, MixingEngine::maxOutputChannels);
     std::vector<juce::AudioChannelSet::ChannelType> chan_types;
     chan_types.resize(numM1OutputChannels);
-    output_channel_indices.resize(numM1OutputChannels);
 
     if (!chanset.isDiscreteLayout())
     { // Check for DAW specific instructions
@@ -768,23 +939,52 @@ void M1PannerAudioProcessor::fillChannelOrderArray(int numM1OutputChannels)
     }
 }
 
-void M1PannerAudioProcessor::updateM1EncodePoints()
+void M1PannerAudioProcessor::publishChannelConfiguration()
 {
-    applyStateToEncode(pannerSettings.m1Encode, getUiReticleSnapshotState());
-    float old_gain_comp = gain_comp_in_db;
-    gain_comp_in_db = pannerSettings.m1Encode.getGainCompensation(true); // store new gain compensation
+    auto& configuration = channelConfigurations.getWriteBuffer();
+    configuration.numInputs = juce::jmin(pannerSettings.m1Encode.getInputChannelsCount(), MixingEngine::maxInputChannels);
+    configuration.numOutputs = juce::jmin(pannerSettings.m1Encode.getOutputChannelsCount(), MixingEngine::maxOutputChannels);
+    std::copy(output_channel_indices.begin(), output_channel_indices.begin() + configuration.numOutputs, configuration.outputChannelIndices.begin());
+    channelConfigurations.publish();
+}
 
-    // Debug output for gain compensation changes
-    if (std::abs(old_gain_comp - gain_comp_in_db) > 0.1f)
+void M1PannerAudioProcessor::applyChannelConfiguration(const ChannelConfiguration& configuration) noexcept
+{
+    auto& currentEngine = mixingEngines[(size_t)activeMixer.load(std::memory_order_relaxed)];
+    if (configuration.numInputs != currentEngine.getNumInputChannels() || configuration.numOutputs != currentEngine.getNumOutputChannels())
     {
-        DBG("Gain compensation changed: " + juce::String(old_gain_comp, 2) + " -> " + juce::String(gain_comp_in_db, 2) +
-            " dB (Az: " + juce::String(pannerSettings.azimuth, 1) + "°, Div: " + juce::String(pannerSettings.diverge, 1) + "%)");
+        // the running mixer fades out into the previous output order while the other one starts silent
+        // and ramps in once the coefficient producer delivers a frame for the new channel counts
+        currentEngine.fadeOut();
+        fadingConfiguration = activeConfiguration;
+        fadingSamplesRemaining = currentEngine.getRampLengthInSamples();
+        mixerFadingOut = fadingSamplesRemaining > 0;
+
+        const int nextMixer = 1 - activeMixer.load(std::memory_order_relaxed);
+        mixingEngines[(size_t)nextMixer].setChannelCounts(configuration.numInputs, configuration.numOutputs);
+        activeMixer.store(nextMixer, std::memory_order_relaxed);
+
+#ifdef COEFFICIENT_LUT
+        coefficientTablePositionValid = false;
+#endif
     }
+
+    // a different host channel order alone is applied straight away
+    activeConfiguration = configuration;
+}
+
+M1PannerAudioProcessor::MixPathCounters M1PannerAudioProcessor::getMixPathCounters() const
+{
+    MixPathCounters counters;
+    counters.rampedBlocks = rampedMixBlocks.load(std::memory_order_relaxed);
+    counters.steadyBlocks = steadyMixBlocks.load(std::memory_order_relaxed);
+    return counters;
 }
 
 void M1PannerAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
     juce::ScopedNoDenormals noDenormals;
+    RealtimeGuard::ScopedProcessBlock realtimeScope(realtimeGuard);
 
     // Use this method as the place to do any pre-playback
     if (!layoutCreated.load())
@@ -793,10 +993,21 @@ void M1PannerAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce
         return;
     }
 
-    if (needToUpdateM1EncodePoints.load())
+    // One coherent view of the parameters for the whole block, writers may publish from any thread meanwhile
+    const auto params = parameterSnapshot.read();
+
+    // Swap in the newest i/o configuration, a change of channel counts crossfades between the two mixers.
+    // A configuration published during a crossfade waits until the previous one has finished
+    if (!mixerFadingOut && channelConfigurations.acquireLatest())
     {
-        updateM1EncodePoints();
-        needToUpdateM1EncodePoints.store(false);
+        applyChannelConfiguration(channelConfigurations.getReadBuffer());
+    }
+    auto& mixingEngine = mixingEngines[(size_t)activeMixer.load(std::memory_order_relaxed)];
+
+    // Pick up the newest gain matrix published by the coefficient producer
+    if (coefficientProducer.acquireLatest())
+    {
+        gain_comp_in_db = coefficientProducer.getCurrentFrame().gainCompensationDb; // store new gain compensation
     }
 
     // Update the host playhead data external usage
@@ -812,207 +1023,354 @@ void M1PannerAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce
         }
     }
 
-    // Set m1Encode obj values for processing
-    auto gainCoeffs = pannerSettings.m1Encode.getGains();
-
-    // vector of input channel buffers
-    juce::AudioSampleBuffer mainInput = getBusBuffer(buffer, true, 0);
-    juce::AudioChannelSet inputLayout = getChannelLayoutOfBus(true, 0);
-
-    // output buffers
-    juce::AudioSampleBuffer mainOutput = getBusBuffer(buffer, false, 0);
-
-#ifdef ITD_PARAMETERS
-    mDelayTimeSmoother.setTargetValue(delayTimeParameter->get());
-    const float udtime = mDelayTimeSmoother.getNextValue() * mSampleRate / 1000000; // number of samples in a microsecond * number of microseconds
-#endif
+    const int numSamples = buffer.getNumSamples();
 
-    // input pan balance for stereo input
-    if (mainInput.getNumChannels() > 1 && pannerSettings.m1Encode.getInputMode() == Mach1EncodeInputMode::Stereo)
+    // Hosts may exceed the block size announced in prepareToPlay(), only then the scratch memory has to grow
+    if (numSamples > outputScratch.getNumSamples())
     {
-        // Only apply stereo input balance if it's not at default (0)
-        if (std::abs(pannerSettings.stereoInputBalance) > 0.001f)
-        {
-            float p = juce::MathConstants<float>::pi * (pannerSettings.stereoInputBalance + 1) / 4;
-            mainInput.applyGain(0, 0, buffer.getNumSamples(), std::cos(p)); // gain for Left
-            mainInput.applyGain(1, 0, buffer.getNumSamples(), std::sin(p)); // gain for Right
-        }
+        RealtimeGuard::ScopedExemption oversizedBlock;
+        outputScratch.setSize(outputScratch.getNumChannels(), numSamples, false, false, true);
     }
 
-    // resize the processing buffer and zero it out so it works despite how many of the expected channels actually exist host side
-    audioDataIn.resize(mainInput.getNumChannels()); // resizing the process data to what the host can support
-    // TODO: error handle for when requested m1Encode input size is more than the host supports
-    for (int input_channel = 0; input_channel < mainInput.getNumChannels(); input_channel++)
+    // Collect the main bus channel pointers without building temporary AudioBuffers,
+    // referencing more than 32 channels in a juce::AudioBuffer allocates
+    const int numHostInputs = juce::jmin(getMainBusNumInputChannels(), MixingEngine::maxInputChannels);
+    const int numHostOutputs = juce::jmin(getMainBusNumOutputChannels(), MixingEngine::maxOutputChannels);
+    for (int input_channel = 0; input_channel < numHostInputs; input_channel++)
     {
-        audioDataIn[input_channel].resize(buffer.getNumSamples(), 0.0);
+        hostInputs[input_channel] = buffer.getReadPointer(getChannelIndexInProcessBlockBuffer(true, 0, input_channel));
     }
+    for (int output_channel = 0; output_channel < numHostOutputs; output_channel++)
+    {
+        hostOutputs[output_channel] = buffer.getWritePointer(getChannelIndexInProcessBlockBuffer(false, 0, output_channel));
+    }
+
+    // The mixers read the host inputs in place, the stereo input balance is part of the gain matrix (see getInputTrims()).
+    // A mixer fading out after a mode change may still read more inputs than the active one
+    const int numMixerInputs = juce::jmin(numHostInputs, juce::jmax(mixingEngine.getNumInputChannels(), mixerFadingOut ? fadingConfiguration.numInputs : 0));
 
     // input channel setup loop
-    for (int input_channel = 0; input_channel < pannerSettings.m1Encode.getInputChannelsCount(); input_channel++)
+    const auto& coefficientFrame = coefficientProducer.getCurrentFrame();
+#ifdef COEFFICIENT_LUT
+    const CoefficientTable* coefficientTable = coefficientProducer.acquireTable();
+    if (coefficientTable != nullptr
+        && (coefficientTable->getKey() != coefficientFrame.tableKey
+            || coefficientTable->getNumInputChannels() != mixingEngine.getNumInputChannels()
+            || coefficientTable->getNumOutputChannels() != mixingEngine.getNumOutputChannels()))
     {
-        if (input_channel > mainInput.getNumChannels() - 1)
+        // the table for the current i/o and panner settings is still being built
+        coefficientTable = nullptr;
+        coefficientTablePositionValid = false;
+    }
+#else
+    const CoefficientTable* coefficientTable = nullptr;
+#endif
+    // TODO: error handle for when requested m1Encode input size is more than the host supports
+    for (int input_channel = 0; input_channel < mixingEngine.getNumInputChannels(); input_channel++)
+    {
+        if (input_channel > numHostInputs - 1)
         {
             // Input channel is missing, set its gains to zero
-            for (int output_channel = 0; output_channel < pannerSettings.m1Encode.getOutputChannelsCount(); output_channel++)
+            for (int output_channel = 0; output_channel < mixingEngine.getNumOutputChannels(); output_channel++)
             {
-                smoothedChannelCoeffs[input_channel][output_channel].setTargetValue(0.0f);
+                mixingEngine.setTargetGain(input_channel, output_channel, 0.0f);
             }
+            mixerInputs[input_channel] = nullptr; // Skip processing for missing input channels
         }
         else
         {
-            // Copy input data to additional buffer
-            memcpy(audioDataIn[input_channel].data(), mainInput.getReadPointer(input_channel), sizeof(float) * buffer.getNumSamples());
-
-            // output channel setup loop
-            for (int output_channel = 0; output_channel < pannerSettings.m1Encode.getOutputChannelsCount(); output_channel++)
+            // Set coefficients using M1 channel order (reordering applied later), frames produced for a previous i/o mode are ignored
+            if (coefficientTable == nullptr && coefficientFrame.numInputs == mixingEngine.getNumInputChannels() && coefficientFrame.numOutputs == mixingEngine.getNumOutputChannels())
             {
-                // Set coefficients using M1 channel order (reordering applied later)
-                smoothedChannelCoeffs[input_channel][output_channel].setTargetValue(gainCoeffs[input_channel][output_channel]);
+                mixingEngine.setTargetGains(input_channel, coefficientFrame.getRow(input_channel));
             }
+
+            // Skip processing if channel is muted
+            mixerInputs[input_channel] = channelMuteStates[input_channel] ? nullptr : hostInputs[input_channel];
         }
     }
 
-    // multichannel temp buffer (also used for informing meters even when not processing to write pointers
-    // Note: Use buf.getNumChannels() for output size from this point on to not mismatch from new m1Encode size requests
-    juce::AudioBuffer<float> buf(pannerSettings.m1Encode.getOutputChannelsCount(), buffer.getNumSamples());
-    buf.clear();
-    // multichannel output buffer (if internal processing is active this will have the above copy into it)
-    float* const* outBuffer = mainOutput.getArrayOfWritePointers();
-
-    // prepare the output buffer - clear all channels efficiently
-    mainOutput.clear();
+    // Note: Use numMixChannels for output size from this point on to not mismatch from new m1Encode size requests
+    const int numMixChannels = mixingEngine.getNumOutputChannels();
 
-    // processing loop
-    for (int input_channel = 0; input_channel < pannerSettings.m1Encode.getInputChannelsCount(); input_channel++)
+    // silence fast path: once the inputs the mixer reads (muted ones count as silent) have been quiet for the
+    // hold time and no gain is still ramping, cleared outputs are all there is to do, mixing, ITD and the
+    // meter levels are skipped. This has to look at the inputs before any output that shares their memory is written
+    const bool inputsHeldSilent = silenceDetector.process(mixerInputs.data(), juce::jmin(numHostInputs, mixingEngine.getNumInputChannels()), numSamples);
+    if (inputsHeldSilent && mixingEngine.isConverged() && !mixerFadingOut)
     {
-        if (input_channel > mainInput.getNumChannels() - 1)
+        for (int output_channel = 0; output_channel < numHostOutputs; output_channel++)
         {
-            // Skip processing for missing input channels
-            DBG("SKIPPING Input[" + juce::String(input_channel) + "] - missing input channel");
-            continue;
+            juce::FloatVectorOperations::clear(hostOutputs[output_channel], numSamples);
         }
 
-        // Skip processing if channel is muted
-        if (channelMuteStates[input_channel])
-        {
-            DBG("SKIPPING Input[" + juce::String(input_channel) + "] - channel muted");
-            continue;
-        }
+        silenceDetector.countBlock(true);
+#ifdef COEFFICIENT_LUT
+        coefficientProducer.releaseTable();
+        coefficientTablePositionValid = false; // jump to the current position once sound resumes
+#endif
+#ifdef ITD_PARAMETERS
+        itdWasActive = false; // the delay lines were not fed, clear them once sound resumes
+#endif
+        outputMeters.beginBlock(numHostOutputs, numSamples);
+        outputMeters.endBlock();
+        return;
+    }
+    silenceDetector.countBlock(false);
 
-        for (int sample = 0; sample < buffer.getNumSamples(); sample++)
+    // prepare the output buffer. Output and input share memory in the host buffer, an output that aliases
+    // an input the mixers read is accumulated in outputScratch instead and copied over once mixing is done
+    int numAliasedOutputs = 0;
+    for (int output_channel = 0; output_channel < numHostOutputs; output_channel++)
+    {
+        mixTargets[output_channel] = hostOutputs[output_channel];
+        for (int input_channel = 0; input_channel < numMixerInputs; input_channel++)
         {
-            // break if expected input channel num size does not match current input channel num size from host
-            if (input_channel > mainInput.getNumChannels() - 1)
+            if (hostOutputs[output_channel] == hostInputs[input_channel])
             {
+                mixTargets[output_channel] = outputScratch.getWritePointer(numAliasedOutputs);
+                aliasedOutputs[numAliasedOutputs++] = output_channel;
                 break;
             }
-            else
-            {
-                // Get each input sample per channel
-                float inValue = audioDataIn[input_channel][sample];
+        }
+        juce::FloatVectorOperations::clear(mixTargets[output_channel], numSamples);
+    }
 
-                // Apply to each of the output channels per input channel
-                for (int output_channel = 0; output_channel < buf.getNumChannels(); output_channel++)
-                {
-                    // break if expected output channel num size does not match current output channel num size from host
+    // mix straight into the host channels, the reordering from fillChannelOrderArray() is applied through
+    // the output pointers and outputs missing from the host layout are skipped
+    for (int output_channel = 0; output_channel < numMixChannels; output_channel++)
+    {
+        const int output_channel_reordered = activeConfiguration.outputChannelIndices[output_channel];
+        mixerOutputs[output_channel] = juce::isPositiveAndBelow(output_channel_reordered, numHostOutputs) ? mixTargets[output_channel_reordered] : nullptr;
+    }
+    // multichannel output buffer in M1 channel order
+    float* const* outBuffer = mixerOutputs.data();
 
-                    // Output channel reordering from fillChannelOrder()
-                    int output_channel_reordered = output_channel_indices[output_channel];
+    // the mixer accumulates the meter levels while it finishes each output
+    mixingEngine.resetOutputLevels();
 
-                    // process via temp buffer that will also be used for meters
-                    if (output_channel_reordered >= 0)
-                    {
-                        // Get the next Mach1Encode coeff
-                        float spatialGainCoeff = smoothedChannelCoeffs[input_channel][output_channel].getNextValue();
-                        buf.addSample(output_channel, sample, inValue * spatialGainCoeff);
-                    }
+    // processing loop
+    auto mixPath = MixingEngine::Path::none;
+#ifdef COEFFICIENT_LUT
+    if (coefficientTable != nullptr)
+    {
+        mixPath = mixWithCoefficientTable(*coefficientTable, params, juce::jmin(numHostInputs, mixingEngine.getNumInputChannels()), numSamples);
+    }
+    else
+    {
+        mixPath = mixingEngine.process(mixerInputs.data(), mixerOutputs.data(), 0, numSamples);
+    }
+    coefficientProducer.releaseTable();
+#else
+    mixPath = mixingEngine.process(mixerInputs.data(), mixerOutputs.data(), 0, numSamples);
+#endif
+
+    // the mixer replaced by a mode change keeps mixing the previous configuration until it has faded out,
+    // into the same outputs so both go through the ITD stage below
+    const bool fadedThisBlock = mixerFadingOut;
+    if (mixerFadingOut)
+    {
+        auto& fadingEngine = mixingEngines[(size_t)(1 - activeMixer.load(std::memory_order_relaxed))];
+        for (int input_channel = 0; input_channel < fadingConfiguration.numInputs; input_channel++)
+        {
+            const bool available = input_channel < numHostInputs && !channelMuteStates[(size_t)input_channel];
+            fadingMixerInputs[input_channel] = available ? hostInputs[input_channel] : nullptr;
+        }
+        for (int output_channel = 0; output_channel < fadingConfiguration.numOutputs; output_channel++)
+        {
+            const int output_channel_reordered = fadingConfiguration.outputChannelIndices[output_channel];
+            fadingMixerOutputs[output_channel] = juce::isPositiveAndBelow(output_channel_reordered, numHostOutputs) ? mixTargets[output_channel_reordered] : nullptr;
+        }
+
+        fadingEngine.resetOutputLevels();
+        mixPath = MixingEngine::combine(mixPath, fadingEngine.process(fadingMixerInputs.data(), fadingMixerOutputs.data(), 0, numSamples));
+
+        // the fade lasts exactly one ramp, every pair has reached zero by then
+        fadingSamplesRemaining -= numSamples;
+        mixerFadingOut = fadingSamplesRemaining > 0;
+    }
+
+    // one count per host block, however many sub-blocks and mixers it took
+    if (mixPath == MixingEngine::Path::steady)
+        steadyMixBlocks.fetch_add(1, std::memory_order_relaxed);
+    else if (mixPath == MixingEngine::Path::ramped)
+        rampedMixBlocks.fetch_add(1, std::memory_order_relaxed);
+    lastMixPath.store(mixPath, std::memory_order_relaxed);
 
-                    if (external_spatialmixer_active || mainOutput.getNumChannels() <= 2)
-                    { // TODO: check if this doesnt catch too many false cases of hosts not utilizing multichannel output
-                        /// ANYTHING REQUIRED ONLY FOR EXTERNAL MIXER GOES HERE
-                    }
-                    else
-                    {
-                        /// ANYTHING THAT IS ONLY FOR INTERNAL MULTICHANNEL PROCESSING GOES HERE
-                        if (output_channel > mainOutput.getNumChannels() - 1)
-                        {
-                            // TODO: Test for external_mixer?
-                            break;
-                        }
-                        else
-                        {
 #ifdef ITD_PARAMETERS
-                            //SIMPLE DELAY
-                            // scale delayCoeffs to be normalized
-                            for (int i = 0; i < pannerSettings.m1Encode.getInputChannelsCount(); i++)
-                            {
-                                for (int o = 0; o < pannerSettings.m1Encode.getOutputChannelsCount(); o++)
-                                {
-                                    delayCoeffs[i][o] = std::min(0.25f, delayCoeffs[i][o]); // clamp maximum to .25f
-                                    delayCoeffs[i][o] *= 4.0f; // rescale range to 0.0->1.0
-                                    // Incorporate the distance delay multiplier
-                                    // using min to correlate delayCoeffs as multiplier increases
-                                    //delayCoeffs[i][o] = std::min<float>(1.0f, (delayCoeffs[i][o]+0.01f) * (float)delayDistanceParameter->get()/100.);
-                                    //delayCoeffs[i][o] *= delayDistanceParameter->get()/10.;
-                                }
-                            }
-
-                            if ((bool)*itdParameter)
-                            {
-                                for (int sample = 0; sample < numSamples; sample++)
-                                {
-                                    // write original to delay
-                                    float udtime = mDelayTimeSmoother.getNextValue() * mSampleRate / 1000000; // number of samples in a microsecond * number of microseconds
-                                    for (auto channel = 0; channel < pannerSettings.m1Encode.getOutputChannelsCount(); channel++)
-                                    {
-                                        ring->pushSample(channel, outBuffer[channel][sample]);
-                                    }
-                                    for (int channel = 0; channel < pannerSettings.m1Encode.getOutputChannelsCount(); channel++)
-                                    {
-                                        outBuffer[channel][sample] = (outBuffer[channel][sample] * 0.707106781) + (ring->getSampleAtDelay(channel, udtime * delayCoeffs[0][channel]) * 0.707106781); // pan-law applied via `0.707106781`
-                                    }
-                                    ring->increment();
-                                }
-                            }
-#endif // end of ITD_PARAMETERS
-                        }
-                    }
-                }
-            }
+    // while the ITD latency is reported every output gets at least the dry path delay. The blend itself is
+    // only for internal multichannel processing with a frame for the current layout, it follows the first
+    // input's encoder gains before the stereo input balance is applied
+    const bool itdLatencyActive = itdLatencyReported.load(std::memory_order_relaxed) && itdProcessor.isAllocated();
+    if (itdLatencyActive)
+    {
+        if (!itdWasActive)
+            itdProcessor.reset();
+
+        /// ANYTHING THAT IS ONLY FOR INTERNAL MULTICHANNEL PROCESSING GOES HERE
+        if (params.itdActive && !external_spatialmixer_active && numHostOutputs > 2 && coefficientFrame.numOutputs == numMixChannels)
+            itdProcessor.setTargets(coefficientFrame.untrimmedFirstRow.data(), numMixChannels, params.delayTime);
+        else
+            itdProcessor.setDryTargets();
+
+        // M1 channel order, followed by the host outputs only the outgoing mixer wrote in the spare delay lines
+        int numItdChannels = juce::jmin(numMixChannels, ITDProcessor::maxChannels);
+        std::copy(outBuffer, outBuffer + numItdChannels, itdChannels.begin());
+        for (int output_channel = 0; fadedThisBlock && output_channel < fadingConfiguration.numOutputs && numItdChannels < ITDProcessor::maxChannels; output_channel++)
+        {
+            float* const channel = fadingMixerOutputs[output_channel];
+            if (channel != nullptr && std::find(itdChannels.begin(), itdChannels.begin() + numItdChannels, channel) == itdChannels.begin() + numItdChannels)
+                itdChannels[(size_t)numItdChannels++] = channel;
         }
+        itdProcessor.process(itdChannels.data(), numItdChannels, numSamples);
+    }
+    itdWasActive = itdLatencyActive;
+    const bool outputsChangedAfterMix = fadedThisBlock || itdLatencyActive;
+#else
+    const bool outputsChangedAfterMix = fadedThisBlock;
+#endif
+
+    // no input is read anymore, hand the outputs that were mixed aside back to the host
+    for (int aliased = 0; aliased < numAliasedOutputs; aliased++)
+    {
+        juce::FloatVectorOperations::copy(hostOutputs[aliasedOutputs[aliased]], outputScratch.getReadPointer(aliased), numSamples);
     }
 
-    // Apply channel reordering to the output buffer
-    for (int output_channel = 0; output_channel < buf.getNumChannels(); output_channel++)
+    // publish the levels gathered during the mix, channels not fed by the mixer read as silent
+    outputMeters.beginBlock(numHostOutputs, numSamples);
+    if (!outputsChangedAfterMix)
     {
-        int output_channel_reordered = output_channel_indices[output_channel];
-        if (output_channel_reordered >= 0)
+        for (int output_channel = 0; output_channel < numMixChannels; output_channel++)
         {
-            for (int sample = 0; sample < buffer.getNumSamples(); sample++)
+            if (mixerOutputs[output_channel] != nullptr)
             {
-                mainOutput.addSample(output_channel_reordered, sample, buf.getSample(output_channel, sample));
+                const auto level = mixingEngine.getOutputLevel(output_channel);
+                outputMeters.pushLevel(activeConfiguration.outputChannelIndices[output_channel], level.sumOfSquares, level.peak);
             }
         }
     }
+    else
+    {
+        // the outgoing mixer or the ITD stage changed the outputs after the mixer measured them
+        const auto& kernels = DspKernels::get();
+        for (int output_channel = 0; output_channel < numHostOutputs; output_channel++)
+        {
+            DspLevel level;
+            kernels.measure(hostOutputs[output_channel], numSamples, level);
+            outputMeters.pushLevel(output_channel, level.sumOfSquares, level.peak);
+        }
+    }
+    outputMeters.endBlock();
+}
+
+#ifdef COEFFICIENT_LUT
+MixingEngine::Path M1PannerAudioProcessor::mixWithCoefficientTable(const CoefficientTable& table, const ParameterSnapshot& params, int numInputs, int numSamples)
+{
+    auto& mixingEngine = mixingEngines[(size_t)activeMixer.load(std::memory_order_relaxed)];
+
+    // Position at the end of this block, the encoder settings are resolved exactly like applyStateToEncode()
+    float diverge = params.diverge;
+    float gain = params.gain;
+    applyMonitorModeToPosition(params.monitorMode, diverge, gain);
+
+    CoefficientTablePosition target;
+    target.azimuth = params.azimuth;
+    target.elevation = params.elevation;
+    target.diverge = diverge / 100.0f;
+    target.gain = juce::Decibels::decibelsToGain(gain);
+
+    // the table is built without input trims, they are applied to the interpolated rows like the producer does
+    CoefficientFrame::InputTrims inputTrims;
+    getInputTrims(params.inputMode, params.stereoInputBalance, inputTrims);
+
+    if (!coefficientTablePositionValid)
+    {
+        coefficientTablePosition = target;
+        coefficientTablePositionValid = true;
+    }
 
-    // update meters
-         outputMeterValuedB.resize(mainOutput.getNumChannels()); // expand meter UI number
-     for (int output_channel = 0; output_channel < mainOutput.getNumChannels(); output_channel++)
-     {
-         outputMeterValuedB.set(output_channel, output_channel < mainOutput.getNumChannels() ? juce::Decibels::gainToDecibels(mainOutput.getRMSLevel(output_channel, 0, buffer.getNumSamples())) : -144);
-     }
+    // move along the shortest way around the circle
+    float azimuthDelta = target.azimuth - coefficientTablePosition.azimuth;
+    azimuthDelta -= 360.0f * std::round(azimuthDelta / 360.0f);
+
+    // interpolate the position across the block and ramp the gains linearly between control points
+    auto path = MixingEngine::Path::none;
+    for (int startSample = 0; startSample < numSamples; startSample += coefficientTableControlInterval)
+    {
+        const int length = juce::jmin(coefficientTableControlInterval, numSamples - startSample);
+        const float t = (float)(startSample + length) / (float)numSamples;
+
+        table.lookup(coefficientTablePosition.azimuth + azimuthDelta * t,
+            juce::jmap(t, coefficientTablePosition.elevation, target.elevation),
+            juce::jmap(t, coefficientTablePosition.diverge, target.diverge),
+            juce::jmap(t, coefficientTablePosition.gain, target.gain),
+            coefficientTableGains.data(),
+            CoefficientFrame::rowStride);
+
+        for (int input_channel = 0; input_channel < numInputs; input_channel++)
+        {
+            float* row = coefficientTableGains.data() + input_channel * CoefficientFrame::rowStride;
+            if (inputTrims[(size_t)input_channel] != 1.0f)
+                juce::FloatVectorOperations::multiply(row, inputTrims[(size_t)input_channel], table.getNumOutputChannels());
+
+            mixingEngine.setTargetGains(input_channel, row, length);
+        }
+        path = MixingEngine::combine(path, mixingEngine.process(mixerInputs.data(), mixerOutputs.data(), startSample, length));
+    }
+
+    coefficientTablePosition = target;
+    return path;
 }
+#endif
 
 void M1PannerAudioProcessor::timerCallback()
 {
+    publishParameterSnapshotIfNeeded();
+
+    if (realtimeGuard.hasNewViolations())
+    {
+        const auto report = realtimeGuard.getReport();
+        DBG("[RT] processBlock() violated realtime constraints in " + juce::String(report.violatingBlocks) + " block(s): "
+            + juce::String(report.allocations) + " allocation(s), " + juce::String(report.lockAcquisitions) + " lock acquisition(s)");
+    }
+
+   #if JUCE_DEBUG
+    const auto mixPath = lastMixPath.load(std::memory_order_relaxed);
+    if (mixPath != lastReportedMixPath)
+    {
+        const auto counters = getMixPathCounters();
+        DBG("[Mix] " + juce::String(mixPath == MixingEngine::Path::steady ? "steady" : "ramped") + " path | ramped blocks: "
+            + juce::String(counters.rampedBlocks) + " | steady blocks: " + juce::String(counters.steadyBlocks));
+        lastReportedMixPath = mixPath;
+    }
+
+    if (silenceDetector.isSkipping() != lastReportedSilence)
+    {
+        const auto stats = silenceDetector.getStats();
+        DBG("[Silence] " + juce::String(silenceDetector.isSkipping() ? "skipping" : "processing") + " | skipped blocks: "
+            + juce::String(stats.skippedBlocks) + " of " + juce::String(stats.skippedBlocks + stats.processedBlocks));
+        lastReportedSilence = !lastReportedSilence;
+    }
+   #endif
+
     applyPendingModeChange();
     applyPendingStereoParameterReset();
 
-    pannerOSC->update(); // test for connection
+#ifdef ITD_PARAMETERS
+    if (pendingITDStateChange.exchange(false))
+    {
+        const bool itdActive = parameterSnapshot.read().itdActive;
+        if (itdActive)
+            itdProcessor.allocate();
+        itdLatencyReported.store(itdActive, std::memory_order_relaxed);
+        setLatencySamples(itdActive ? ITDProcessor::getLatencySamples() : 0);
+    }
+#endif
 
-    if (pendingPannerSettingsSend.load() && pannerOSC->isConnected() && sendCurrentPannerSettings())
+    // the settings themselves are polled by the telemetry stream, changes go out as deltas
+    if (pendingTelemetryKeyframe.exchange(false))
     {
-        pendingPannerSettingsSend.store(false);
+        pannerOSC->requestTelemetryKeyframe();
     }
 }
 
@@ -1032,6 +1390,22 @@ juce::AudioProcessorEditor* M1PannerAudioProcessor::createEditor()
     return new M1PannerAudioProcessorEditor(*this);
 }
 
+void M1PannerAudioProcessor::syncUiCoordinatesFromParameters()
+{
+    // only when a parameter was published since the last frame, x/y are left alone while an editor control drags them
+    const auto version = parameterSnapshot.getVersion();
+    if (uiCoordinatesVersion.exchange(version) == version)
+    {
+        return;
+    }
+
+    if (!azimuthOwnedByUI.load() && !divergeOwnedByUI.load())
+    {
+        const auto params = parameterSnapshot.read();
+        convertRCtoXYRaw(params.azimuth, params.diverge, pannerSettings.x, pannerSettings.y);
+    }
+}
+
 void M1PannerAudioProcessor::convertRCtoXYRaw(float r, float d, float& x, float& y)
 {
     x = cos(juce::degreesToRadians(-r + 90)) * d * sqrt(2);
@@ -1094,53 +1468,50 @@ void M1PannerAudioProcessor::m1EncodeChangeInputOutputMode(Mach1EncodeInputMode
     auto inputChannelsCount = pannerSettings.m1Encode.getInputChannelsCount();
     auto outputChannelsCount = pannerSettings.m1Encode.getOutputChannelsCount();
 
-    // Initialize all channels as unmuted
-    channelMuteStates.resize(inputChannelsCount, false);
-
-    // Size smoothedChannelCoeffs to M1 canonical channel count
-    smoothedChannelCoeffs = std::vector<std::vector<juce::LinearSmoothedValue<float>>>(inputChannelsCount, std::vector<juce::LinearSmoothedValue<float>>(outputChannelsCount));
-    for (int in = 0; in < inputChannelsCount; ++in)
+    // Channels that are not part of the new input mode start unmuted if it is selected again
+    for (int input_channel = (int)inputChannelsCount; input_channel < MixingEngine::maxInputChannels; input_channel++)
     {
-        for (int out = 0; out < outputChannelsCount; ++out)
-        {
-            smoothedChannelCoeffs[in][out].setCurrentAndTargetValue(smoothedChannelCoeffs[in][out].getTargetValue());
-        }
+        channelMuteStates[(size_t)input_channel] = false;
     }
-    output_channel_indices.resize(outputChannelsCount);
 
     // Checks if output bus is non DISCRETE layout and fixes host specific channel ordering issues
     fillChannelOrderArray(outputChannelsCount);
 
-    for (int input_channel = 0; input_channel < inputChannelsCount; input_channel++)
-    {
-        smoothedChannelCoeffs[input_channel] = std::vector<juce::LinearSmoothedValue<float>>();
-        smoothedChannelCoeffs[input_channel].resize(outputChannelsCount);
-        for (int output_channel = 0; output_channel < outputChannelsCount; output_channel++)
-        {
-            smoothedChannelCoeffs[input_channel][output_channel].reset(processorSampleRate, (double)0.01);
-        }
-    }
+    // The audio thread swaps the mixer over to the new channel counts at the start of its next block
+    publishChannelConfiguration();
+
+    const int newInputMode = static_cast<int>(pannerSettings.m1Encode.getInputMode());
+    const int newOutputMode = static_cast<int>(pannerSettings.m1Encode.getOutputMode());
+    parameterSnapshot.update([=](ParameterSnapshot& snapshot) {
+        snapshot.inputMode = newInputMode;
+        snapshot.inputChannelsCount = (int)inputChannelsCount;
+        snapshot.outputMode = newOutputMode;
+    });
 
-    needToUpdateM1EncodePoints.store(true); // need to call to update the m1encode obj for new point counts
+    coefficientProducer.requestUpdate(); // need to call to update the m1encode obj for new point counts
     uiReticleSnapshotDirty.store(true);
 }
 
 M1PannerAudioProcessor::UiReticleSnapshotState M1PannerAudioProcessor::getUiReticleSnapshotState()
 {
+    // one coherent snapshot, this runs on the encoder thread and the editor threads
+    const auto params = parameterSnapshot.read();
+
     UiReticleSnapshotState state;
-    state.azimuth = pannerSettings.azimuth;
-    state.elevation = pannerSettings.elevation;
-    state.diverge = pannerSettings.diverge;
-    state.gain = pannerSettings.gain;
-    state.stereoOrbitAzimuth = pannerSettings.stereoOrbitAzimuth;
-    state.stereoSpread = pannerSettings.stereoSpread;
-    state.autoOrbit = pannerSettings.autoOrbit;
-    state.isotropicMode = pannerSettings.isotropicMode;
-    state.equalpowerMode = pannerSettings.equalpowerMode;
-    state.gainCompensationMode = pannerSettings.gainCompensationMode;
-    state.monitorMode = monitorSettings.monitor_mode;
-    state.inputMode = static_cast<int>(pannerSettings.m1Encode.getInputMode());
-    state.outputMode = static_cast<int>(pannerSettings.m1Encode.getOutputMode());
+    state.azimuth = params.azimuth;
+    state.elevation = params.elevation;
+    state.diverge = params.diverge;
+    state.gain = params.gain;
+    state.stereoOrbitAzimuth = params.stereoOrbitAzimuth;
+    state.stereoSpread = params.stereoSpread;
+    state.stereoInputBalance = params.stereoInputBalance;
+    state.autoOrbit = params.autoOrbit;
+    state.isotropicMode = params.isotropicMode;
+    state.equalpowerMode = params.equalpowerMode;
+    state.gainCompensationMode = params.gainCompensationMode;
+    state.monitorMode = params.monitorMode;
+    state.inputMode = params.inputMode;
+    state.outputMode = params.outputMode;
     return state;
 }
 
@@ -1152,12 +1523,7 @@ void M1PannerAudioProcessor::applyStateToEncode(Mach1Encode<float>& encode, cons
     encode.setInputMode(static_cast<Mach1EncodeInputMode>(state.inputMode));
     encode.setOutputMode(static_cast<Mach1EncodeOutputMode>(state.outputMode));
 
-    if (state.monitorMode == 1)
-    {
-        const float absDiverge = fabsf((diverge - -100.0f) / (100.0f - -100.0f));
-        gain -= absDiverge * 6.0f;
-        diverge = 0.0f;
-    }
+    applyMonitorModeToPosition(state.monitorMode, diverge, gain);
 
     encode.setAzimuthDegrees(state.azimuth);
     encode.setElevationDegrees(state.elevation);
@@ -1167,86 +1533,72 @@ void M1PannerAudioProcessor::applyStateToEncode(Mach1Encode<float>& encode, cons
     encode.setOrbitRotationDegrees(state.stereoOrbitAzimuth);
     encode.setStereoSpread(state.stereoSpread / 100.0f);
     encode.setGainCompensationActive(state.gainCompensationMode);
-
-    if (state.isotropicMode)
-    {
-        if (state.equalpowerMode)
-        {
-            encode.setPannerMode(Mach1EncodePannerMode::IsotropicEqualPower);
-        }
-        else
-        {
-            encode.setPannerMode(Mach1EncodePannerMode::IsotropicLinear);
-        }
-    }
-    else
-    {
-        encode.setPannerMode(Mach1EncodePannerMode::PeriphonicLinear);
-    }
+    encode.setPannerMode(getPannerMode(state.isotropicMode, state.equalpowerMode));
 
     encode.generatePointResults();
 }
 
 void M1PannerAudioProcessor::refreshUiReticleSnapshotIfNeeded()
 {
-    const auto state = getUiReticleSnapshotState();
-    if (!uiReticleSnapshotDirty.load() && areUiReticleSnapshotStatesEqual(state, lastUiReticleSnapshotState))
+    // another editor thread is refreshing right now, its result is picked up on the next read
+    if (!uiReticleSnapshot.tryBeginWrite())
     {
         return;
     }
 
-    Mach1Encode<float> snapshotEncode;
-    applyStateToEncode(snapshotEncode, state);
-
-    auto points = snapshotEncode.getPoints();
-    auto names = snapshotEncode.getPointsNames();
-
+    // clear the flag before reading the state so a change made meanwhile marks the snapshot dirty again
+    const bool dirty = uiReticleSnapshotDirty.exchange(false);
+    const auto state = getUiReticleSnapshotState();
+    if (dirty || !areUiReticleSnapshotStatesEqual(state, lastUiReticleSnapshotState))
     {
-        const juce::ScopedLock snapshotLock(uiReticleSnapshotLock);
-        uiReticlePoints = std::move(points);
-        uiReticlePointNames = std::move(names);
+        applyStateToEncode(uiReticleEncode, state);
+        uiReticleSnapshot.publish(uiReticleEncode.getPoints(), uiReticleSnapshot.internNames(state.inputMode, state.outputMode, uiReticleEncode));
+        lastUiReticleSnapshotState = state;
     }
 
-    lastUiReticleSnapshotState = state;
-    uiReticleSnapshotDirty.store(false);
+    uiReticleSnapshot.endWrite();
 }
 
-void M1PannerAudioProcessor::getUiReticleSnapshot(std::vector<Mach1Point3D>& points, std::vector<std::string>& names)
+bool M1PannerAudioProcessor::getUiReticleSnapshot(ReticleSnapshotChannel::View& view)
 {
     refreshUiReticleSnapshotIfNeeded();
-
-    const juce::ScopedLock snapshotLock(uiReticleSnapshotLock);
-    points = uiReticlePoints;
-    names = uiReticlePointNames;
+    return uiReticleSnapshot.read(view);
 }
 
-bool M1PannerAudioProcessor::sendCurrentPannerSettings()
+MixerSettings M1PannerAudioProcessor::getMonitorDisplayState(double timeMs) const
 {
-    try
-    {
-        const std::string track_name = track_properties.name.has_value() ? track_properties.name->toStdString() : "";
-        const int panner_mode = pannerSettings.isotropicMode
-            ? static_cast<int>(pannerSettings.equalpowerMode ? Mach1EncodePannerMode::IsotropicEqualPower
-                                                             : Mach1EncodePannerMode::IsotropicLinear)
-            : static_cast<int>(Mach1EncodePannerMode::PeriphonicLinear);
-        return pannerOSC->sendPannerSettings(pannerSettings.state,
-                                             track_name,
-                                             osc_colour,
-                                             static_cast<int>(pannerSettings.m1Encode.getInputMode()),
-                                             pannerSettings.azimuth,
-                                             pannerSettings.elevation,
-                                             pannerSettings.diverge,
-                                             pannerSettings.gain,
-                                             panner_mode,
-                                             pannerSettings.gainCompensationMode,
-                                             pannerSettings.autoOrbit,
-                                             pannerSettings.stereoOrbitAzimuth,
-                                             pannerSettings.stereoSpread);
-    }
-    catch (...)
+    auto state = monitorSettings;
+    MonitorOrientationFeed::Orientation orientation;
+    if (monitorOrientation.getOrientation(timeMs, orientation))
     {
-        return false;
+        state.yaw = orientation.yaw;
+        state.pitch = orientation.pitch;
+        state.roll = orientation.roll;
     }
+    return state;
+}
+
+PannerTelemetry::State M1PannerAudioProcessor::getTelemetryState()
+{
+    // pannerSettings is written by parameterChanged() on whatever thread the host uses, read the published snapshot instead
+    publishParameterSnapshotIfNeeded();
+    const auto params = parameterSnapshot.read();
+
+    PannerTelemetry::State state;
+    state.state = pannerSettings.state;
+    state.displayName = track_properties.name.has_value() ? *track_properties.name : juce::String();
+    state.colour = osc_colour;
+    state.inputMode = params.inputMode;
+    state.azimuth = params.azimuth;
+    state.elevation = params.elevation;
+    state.diverge = params.diverge;
+    state.gain = params.gain;
+    state.pannerMode = static_cast<int>(getPannerMode(params.isotropicMode, params.equalpowerMode));
+    state.gainCompensation = params.gainCompensationMode;
+    state.stereoAutoOrbit = params.autoOrbit;
+    state.stereoAzimuth = params.stereoOrbitAzimuth;
+    state.stereoSpread = params.stereoSpread;
+    return state;
 }
 
 //==============================================================================
@@ -1312,9 +1664,9 @@ void M1PannerAudioProcessor::setStateInformation(const void* data, int sizeInByt
             pannerSettings.lockOutputLayout = (bool) restoredState.getProperty("output_layout_lock", pannerSettings.lockOutputLayout);
             lockOutputLayout = pannerSettings.lockOutputLayout;
 
-            needToUpdateM1EncodePoints.store(true);
+            coefficientProducer.requestUpdate();
             uiReticleSnapshotDirty.store(true);
-            pendingPannerSettingsSend.store(true);
+            pendingTelemetryKeyframe.store(true);
             return;
         }
     }
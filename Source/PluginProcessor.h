@@ -3,22 +3,32 @@
 #include <JuceHeader.h>
 #include <Mach1Encode.h>
 
+#include <array>
 #include <atomic>
 
 #include "Config.h"
 #include "AlertData.h"
+#include "CoefficientProducer.h"
+#include "MeterEngine.h"
+#include "MixingEngine.h"
+#include "MonitorOrientationFeed.h"
 #include "PannerOSC.h"
+#include "ParameterSnapshot.h"
+#include "RealtimeGuard.h"
+#include "ReticleSnapshotChannel.h"
+#include "SilenceDetector.h"
+#include "TripleBuffer.h"
 #include "TypesForDataExchange.h"
 
 #ifdef ITD_PARAMETERS
-    #include "RingBuffer.h"
+    #include "ITDProcessor.h"
 #endif
 
 //==============================================================================
 /**
 */
 class PannerOSC; // forward declare for PannerOSC
-class M1PannerAudioProcessor : public juce::AudioProcessor, juce::AudioProcessorValueTreeState::Listener, juce::Timer
+class M1PannerAudioProcessor : public juce::AudioProcessor, juce::AudioProcessorValueTreeState::Listener
 {
 public:
     //==============================================================================
@@ -74,7 +84,7 @@ public:
     void prepareToPlay(double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
     void parameterChanged(const juce::String& parameterID, float newValue) override;
-    std::vector<int> output_channel_indices; // For reordering channel indices based on specific DAW hosts (example: reordering for ProTools 7.1 channel order)
+    std::array<int, MixingEngine::maxOutputChannels> output_channel_indices {}; // For reordering channel indices based on specific DAW hosts (example: reordering for ProTools 7.1 channel order)
     void fillChannelOrderArray(int numM1OutputChannels);
 
 #ifndef CUSTOM_CHANNEL_LAYOUT
@@ -82,23 +92,6 @@ public:
 #endif
 
     void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
-#ifdef ITD_PARAMETERS
-    void writeToDelayBuffer(juce::AudioSampleBuffer& buffer,
-        const int channelIn,
-        const int channelOut,
-        const int writePos,
-        float startGain,
-        float endGain,
-        bool replacing);
-
-    void readFromDelayBuffer(juce::AudioSampleBuffer& buffer,
-        const int channelIn,
-        const int channelOut,
-        const int readPos,
-        float startGain,
-        float endGain,
-        bool replacing);
-#endif
 
     //==============================================================================
     juce::AudioProcessorEditor* createEditor() override;
@@ -150,13 +143,16 @@ public:
 #endif
 
     // Variables from processor for UI
-    juce::Array<float> outputMeterValuedB;
+    MeterEngine outputMeters; // host channel order, read lock-free by the editor
 
     double processorSampleRate = 44100; // only has to be something for the initilizer to work
     void m1EncodeChangeInputOutputMode(Mach1EncodeInputMode inputMode, Mach1EncodeOutputMode outputMode);
     PannerSettings pannerSettings;
     float gain_comp_in_db = 0;
     MixerSettings monitorSettings;
+    MonitorOrientationFeed monitorOrientation; // every /monitor-settings orientation, timestamped on arrival
+    /// monitorSettings with the orientation interpolated to `timeMs`, for drawing
+    MixerSettings getMonitorDisplayState(double timeMs) const;
     HostTimelineData hostTimelineData;
     juce::PluginHostType hostType;
     void updateTrackProperties(const TrackProperties& properties) override { track_properties = properties; }
@@ -164,13 +160,31 @@ public:
     std::atomic<bool> layoutCreated { false };
     bool lockOutputLayout = false;
 
-    // update m1encode obj points
-    std::atomic<bool> needToUpdateM1EncodePoints { false };
-    void updateM1EncodePoints();
-    void getUiReticleSnapshot(std::vector<Mach1Point3D>& points, std::vector<std::string>& names);
+    /// Editor threads: refreshes the reticle points if the panner state changed and updates `view` if a
+    /// newer snapshot exists, returns false (copying nothing) otherwise. Never blocks.
+    bool getUiReticleSnapshot(ReticleSnapshotChannel::View& view);
+
+    /// Host blocks the mixer handled on each path, a block counts as ramped if any part of it ramped
+    struct MixPathCounters
+    {
+        juce::uint64 rampedBlocks = 0;
+        juce::uint64 steadyBlocks = 0;
+    };
+
+    /// How many host blocks took the ramped and the steady (static matrix) path, any thread
+    MixPathCounters getMixPathCounters() const;
 
-    // Communication to OrientationManager/Monitor and the rest of the M1SpatialSystem
-    void timerCallback() override;
+    /// How many blocks were skipped by the silence fast path since the plugin was loaded
+    SilenceDetector::Stats getSilenceStats() const { return silenceDetector.getStats(); }
+
+#ifdef COEFFICIENT_LUT
+    /// Rebuilds the coefficient table on the producer thread at a new grid resolution, not from the audio thread
+    void setCoefficientTableResolution(const CoefficientTable::Resolution& resolution) { coefficientProducer.enableTable(resolution); }
+#endif
+
+    // Communication to OrientationManager/Monitor and the rest of the M1SpatialSystem,
+    // called on the message thread by the tick that PannerOSCHub shares between all instances
+    void timerCallback();
     std::unique_ptr<PannerOSC> pannerOSC;
     juce::OSCColour osc_colour = { 0, 0, 0, 255 };
 
@@ -215,8 +229,8 @@ public:
     void convertRCtoXYRaw(float r, float d, float& x, float& y);
     void convertXYtoRCRaw(float x, float y, float& r, float& d);
 
-    // Add mute states vector for each input channel
-    std::vector<bool> channelMuteStates;
+    // Mute state of each input channel, sized for the largest input mode so the audio thread can always read it
+    std::array<std::atomic<bool>, MixingEngine::maxInputChannels> channelMuteStates {};
 
     // This will be set by the UI or editor so we can notify it of alerts
     std::function<void(const Mach1::AlertData&)> postAlertToUI;
@@ -231,6 +245,7 @@ public:
         float gain = 0.0f;
         float stereoOrbitAzimuth = 0.0f;
         float stereoSpread = 0.0f;
+        float stereoInputBalance = 0.0f; // not part of the reticle, only used for the input trims
         bool autoOrbit = false;
         bool isotropicMode = false;
         bool equalpowerMode = false;
@@ -243,7 +258,11 @@ public:
     // Flag to prevent recursive parameter conversion during UI coordinate updates
     std::atomic<bool> updatingCoordinatesFromUI { false };
 
-    // Parameter ownership flags - track which UI control is actively managing each parameter
+    /// Editors: follows host and automation changes of azimuth/diverge with `pannerSettings` x/y, call once per frame
+    void syncUiCoordinatesFromParameters();
+
+    // Parameter ownership flags - track which UI control is actively managing each parameter. These are editor
+    // gesture state only, the audio and encoder threads read parameterSnapshot and never consult them
     std::atomic<bool> azimuthOwnedByUI { false };
     std::atomic<bool> elevationOwnedByUI { false };
     std::atomic<bool> divergeOwnedByUI { false };
@@ -263,47 +282,117 @@ private:
     void createLayout();
     void applyPendingModeChange();
     void applyPendingStereoParameterReset();
+    void publishParameterSnapshotIfNeeded();
+    void publishChannelConfiguration();
     UiReticleSnapshotState getUiReticleSnapshotState();
     void refreshUiReticleSnapshotIfNeeded();
     void applyStateToEncode(Mach1Encode<float>& encode, const UiReticleSnapshotState& state);
-    bool sendCurrentPannerSettings();
+    PannerTelemetry::State getTelemetryState();
 
     juce::UndoManager mUndoManager;
     juce::AudioProcessorValueTreeState parameters;
 
     std::atomic<bool> uiReticleSnapshotDirty { true };
-    std::atomic<bool> pendingPannerSettingsSend { true };
+    SnapshotBuffer<ParameterSnapshot> parameterSnapshot; // what every thread but the editor reads the parameters from
+    std::atomic<bool> parameterSnapshotDirty { true }; // set by parameterChanged(), published by the encoder and message threads
+
+    /// The values the parameters hold, read by publishParameterSnapshotIfNeeded()
+    struct RawParameterValues
+    {
+        std::atomic<float>* azimuth = nullptr;
+        std::atomic<float>* elevation = nullptr;
+        std::atomic<float>* diverge = nullptr;
+        std::atomic<float>* gain = nullptr;
+        std::atomic<float>* autoOrbit = nullptr;
+        std::atomic<float>* stereoOrbitAzimuth = nullptr;
+        std::atomic<float>* stereoSpread = nullptr;
+        std::atomic<float>* stereoInputBalance = nullptr;
+        std::atomic<float>* isotropicMode = nullptr;
+        std::atomic<float>* equalpowerMode = nullptr;
+        std::atomic<float>* gainCompensationMode = nullptr;
+#ifdef ITD_PARAMETERS
+        std::atomic<float>* itdActive = nullptr;
+        std::atomic<float>* delayTime = nullptr;
+        std::atomic<float>* delayDistance = nullptr;
+#endif
+    } rawParameterValues;
+    std::atomic<juce::uint32> uiCoordinatesVersion { 0 };
+    std::atomic<bool> pendingTelemetryKeyframe { true }; // the helper needs the full settings again
     std::atomic<bool> pendingModeChange { false };
     std::atomic<bool> pendingStereoParameterReset { false };
     std::atomic<int> requestedInputMode { 0 };
     std::atomic<int> requestedOutputMode { 0 };
     UiReticleSnapshotState lastUiReticleSnapshotState {};
-    juce::CriticalSection uiReticleSnapshotLock;
-    std::vector<Mach1Point3D> uiReticlePoints;
-    std::vector<std::string> uiReticlePointNames;
+    ReticleSnapshotChannel uiReticleSnapshot;
+    Mach1Encode<float> uiReticleEncode; // only used by the thread holding uiReticleSnapshot's write flag
+
+    // Audio thread scratch memory, sized in prepareToPlay() so processBlock() never allocates
+    RealtimeGuard realtimeGuard;
+    juce::AudioBuffer<float> outputScratch; // outputs that share memory with an input the mixers still read
+    std::array<const float*, MixingEngine::maxInputChannels> hostInputs {};
+    std::array<float*, MixingEngine::maxOutputChannels> hostOutputs {};
+    std::array<float*, MixingEngine::maxOutputChannels> mixTargets {}; // host order, the host channel or its scratch stand-in
+    std::array<int, MixingEngine::maxInputChannels> aliasedOutputs {}; // host outputs mixed into outputScratch
+
+    /// Mixer channel counts and host output order of one i/o mode, published by the message thread
+    /// and swapped in by the audio thread at the start of a block
+    struct ChannelConfiguration
+    {
+        int numInputs = 0;
+        int numOutputs = 0;
+        std::array<int, MixingEngine::maxOutputChannels> outputChannelIndices {}; // M1 channel -> host channel
+    };
 
-    // Channel input
-    std::vector<std::vector<float>> audioDataIn;
-    std::vector<std::vector<juce::LinearSmoothedValue<float>>> smoothedChannelCoeffs;
+    void applyChannelConfiguration(const ChannelConfiguration& configuration) noexcept;
+
+    // Both mixers are preallocated for the largest i/o modes. After a mode change the previous one keeps
+    // mixing the old configuration while it fades out and the other one fades in with the new matrix
+    std::array<MixingEngine, 2> mixingEngines;
+    std::atomic<int> activeMixer { 0 }; // written by the audio thread, read by timerCallback()
+    bool mixerFadingOut = false;
+    int fadingSamplesRemaining = 0;
+    ChannelConfiguration activeConfiguration;
+    ChannelConfiguration fadingConfiguration;
+    TripleBuffer<ChannelConfiguration> channelConfigurations;
+    SilenceDetector silenceDetector;
+    std::atomic<MixingEngine::Path> lastMixPath { MixingEngine::Path::none };
+    std::atomic<juce::uint64> rampedMixBlocks { 0 };
+    std::atomic<juce::uint64> steadyMixBlocks { 0 };
+   #if JUCE_DEBUG
+    MixingEngine::Path lastReportedMixPath = MixingEngine::Path::none;
+    bool lastReportedSilence = false;
+   #endif
+    std::array<const float*, MixingEngine::maxInputChannels> mixerInputs {};
+    std::array<float*, MixingEngine::maxOutputChannels> mixerOutputs {};
+    std::array<const float*, MixingEngine::maxInputChannels> fadingMixerInputs {};
+    std::array<float*, MixingEngine::maxOutputChannels> fadingMixerOutputs {};
+
+    // update m1encode obj points off the audio thread, stopped at the top of the destructor
+    CoefficientProducer coefficientProducer;
+
+#ifdef COEFFICIENT_LUT
+    struct CoefficientTablePosition
+    {
+        float azimuth = 0.0f;
+        float elevation = 0.0f;
+        float diverge = 0.0f; // normalised -1->1
+        float gain = 1.0f; // linear
+    };
 
-#ifdef ITD_PARAMETERS
-    inline void processBuffers(AudioSampleBuffer& buffer,
-        std::vector<int> orderChans,
-        std::vector<std::vector<float>> delayCoeffs);
-#else
-    inline void processBuffers(juce::AudioSampleBuffer& buffer,
-        std::vector<int> orderChans);
+    MixingEngine::Path mixWithCoefficientTable(const CoefficientTable& table, const ParameterSnapshot& params, int numInputs, int numSamples);
+
+    static constexpr int coefficientTableControlInterval = MixingEngine::controlBlockSize; // samples between table lookups
+    CoefficientTablePosition coefficientTablePosition;
+    bool coefficientTablePositionValid = false;
+    std::array<float, MixingEngine::maxInputChannels * MixingEngine::maxOutputChannels> coefficientTableGains {};
 #endif
 
 #ifdef ITD_PARAMETERS
-    // Delay init
-    juce::AudioSampleBuffer mDelayBuffer;
-    std::unique_ptr<RingBuffer> ring;
-    juce::SmoothedValue<float, juce::ValueSmoothingTypes::Linear> mDelayTimeSmoother; // smoothing for parameters
-    float mLastInputGain = 0.0f;
-    int mWritePos = 0;
-    int mExpectedReadPos = -1;
-    double mSampleRate = 0;
+    ITDProcessor itdProcessor;
+    bool itdWasActive = false;
+    std::atomic<bool> pendingITDStateChange { false }; // allocation and setLatencySamples() are not realtime safe
+    std::atomic<bool> itdLatencyReported { false }; // the host compensates ITDProcessor::getLatencySamples(), set with setLatencySamples()
+    std::array<float*, ITDProcessor::maxChannels> itdChannels {};
 #endif
 
     //==============================================================================
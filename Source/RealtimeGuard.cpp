@@ -0,0 +1,225 @@
+#include "RealtimeGuard.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+#if JUCE_WINDOWS
+    #include <malloc.h>
+#endif
+
+#if M1_REALTIME_CHECKS
+namespace
+{
+thread_local RealtimeGuard* activeGuard = nullptr;
+thread_local int exemptionDepth = 0;
+}
+
+RealtimeGuard::ScopedProcessBlock::ScopedProcessBlock(RealtimeGuard& guard_) noexcept
+    : guard(guard_), previousGuard(activeGuard)
+{
+    allocationsAtStart = guard.allocations.load(std::memory_order_relaxed);
+    locksAtStart = guard.lockAcquisitions.load(std::memory_order_relaxed);
+    activeGuard = &guard;
+}
+
+RealtimeGuard::ScopedProcessBlock::~ScopedProcessBlock() noexcept
+{
+    if (guard.allocations.load(std::memory_order_relaxed) != allocationsAtStart
+        || guard.lockAcquisitions.load(std::memory_order_relaxed) != locksAtStart)
+    {
+        guard.violatingBlocks.fetch_add(1, std::memory_order_relaxed);
+    }
+    activeGuard = previousGuard;
+}
+
+RealtimeGuard::ScopedExemption::ScopedExemption() noexcept
+{
+    ++exemptionDepth;
+}
+
+RealtimeGuard::ScopedExemption::~ScopedExemption() noexcept
+{
+    --exemptionDepth;
+}
+
+void RealtimeGuard::noteAllocation() noexcept
+{
+    if (activeGuard != nullptr && exemptionDepth == 0)
+        activeGuard->allocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+void RealtimeGuard::noteLockAcquired() noexcept
+{
+    if (activeGuard != nullptr && exemptionDepth == 0)
+        activeGuard->lockAcquisitions.fetch_add(1, std::memory_order_relaxed);
+}
+
+//==============================================================================
+// Replaced global allocation functions, only compiled into builds with the checks enabled. Every
+// form is replaced so that none of them slips past the counter or frees memory the other allocated.
+namespace
+{
+void* allocate(std::size_t size) noexcept
+{
+    RealtimeGuard::noteAllocation();
+    return std::malloc(size > 0 ? size : 1);
+}
+
+#if __cpp_aligned_new
+void* allocateAligned(std::size_t size, std::align_val_t alignment) noexcept
+{
+    RealtimeGuard::noteAllocation();
+    size = size > 0 ? size : 1;
+#if JUCE_WINDOWS
+    return _aligned_malloc(size, (std::size_t)alignment);
+#else
+    // posix_memalign wants at least the alignment of a pointer
+    void* ptr = nullptr;
+    return posix_memalign(&ptr, std::max((std::size_t)alignment, sizeof(void*)), size) == 0 ? ptr : nullptr;
+#endif
+}
+
+void freeAligned(void* ptr) noexcept
+{
+#if JUCE_WINDOWS
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+#endif
+}
+
+void* operator new(std::size_t size)
+{
+    if (auto* ptr = allocate(size))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return allocate(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+    std::free(ptr);
+}
+
+#if __cpp_aligned_new
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    if (auto* ptr = allocateAligned(size, alignment))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return operator new(size, alignment);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return allocateAligned(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return allocateAligned(size, alignment);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept
+{
+    freeAligned(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept
+{
+    freeAligned(ptr);
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept
+{
+    freeAligned(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept
+{
+    freeAligned(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    freeAligned(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    freeAligned(ptr);
+}
+#endif
+#else
+RealtimeGuard::ScopedProcessBlock::ScopedProcessBlock(RealtimeGuard&) noexcept {}
+RealtimeGuard::ScopedProcessBlock::~ScopedProcessBlock() noexcept {}
+RealtimeGuard::ScopedExemption::ScopedExemption() noexcept {}
+RealtimeGuard::ScopedExemption::~ScopedExemption() noexcept {}
+void RealtimeGuard::noteAllocation() noexcept {}
+void RealtimeGuard::noteLockAcquired() noexcept {}
+#endif
+
+RealtimeGuard::Report RealtimeGuard::getReport() const noexcept
+{
+    Report report;
+    report.allocations = allocations.load(std::memory_order_relaxed);
+    report.lockAcquisitions = lockAcquisitions.load(std::memory_order_relaxed);
+    report.violatingBlocks = violatingBlocks.load(std::memory_order_relaxed);
+    return report;
+}
+
+bool RealtimeGuard::hasNewViolations() noexcept
+{
+    const auto current = violatingBlocks.load(std::memory_order_relaxed);
+    if (current == lastReportedViolatingBlocks)
+        return false;
+
+    lastReportedViolatingBlocks = current;
+    return true;
+}
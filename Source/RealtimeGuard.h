@@ -0,0 +1,90 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+#include <atomic>
+
+/// Debug builds count heap allocations and lock acquisitions made while `processBlock()` is running.
+/// Allocations are caught by the replaced global operator new and delete (every plain, array, nothrow
+/// and aligned form), locks only if they call `noteLockAcquired()` or are taken through
+/// `RealtimeGuard::ScopedLock`. Define `M1_REALTIME_CHECKS=1` to enable the checks in other build types,
+/// in release builds all of the scopes below compile to nothing.
+#ifndef M1_REALTIME_CHECKS
+    #if JUCE_DEBUG
+        #define M1_REALTIME_CHECKS 1
+    #else
+        #define M1_REALTIME_CHECKS 0
+    #endif
+#endif
+
+class RealtimeGuard
+{
+public:
+    struct Report
+    {
+        juce::uint32 allocations = 0;
+        juce::uint32 lockAcquisitions = 0;
+        juce::uint32 violatingBlocks = 0;
+    };
+
+    /// Marks the calling thread as the audio thread of `guard` for the lifetime of the scope
+    class ScopedProcessBlock
+    {
+    public:
+        explicit ScopedProcessBlock(RealtimeGuard& guard) noexcept;
+        ~ScopedProcessBlock() noexcept;
+
+    private:
+#if M1_REALTIME_CHECKS
+        RealtimeGuard& guard;
+        RealtimeGuard* previousGuard = nullptr;
+        juce::uint32 allocationsAtStart = 0;
+        juce::uint32 locksAtStart = 0;
+#endif
+        JUCE_DECLARE_NON_COPYABLE(ScopedProcessBlock)
+    };
+
+    /// Excludes a known non-realtime section from the counters, keep these rare and documented
+    class ScopedExemption
+    {
+    public:
+        ScopedExemption() noexcept;
+        ~ScopedExemption() noexcept;
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedExemption)
+    };
+
+    /// A `juce::ScopedLock` that counts as a lock acquisition when it is taken inside processBlock(),
+    /// for the locks the audio thread must never wait on
+    class ScopedLock
+    {
+    public:
+        explicit ScopedLock(const juce::CriticalSection& lock_) noexcept : lock(lock_)
+        {
+            noteLockAcquired();
+            lock.enter();
+        }
+
+        ~ScopedLock() noexcept { lock.exit(); }
+
+    private:
+        const juce::CriticalSection& lock;
+        JUCE_DECLARE_NON_COPYABLE(ScopedLock)
+    };
+
+    static void noteAllocation() noexcept;
+
+    /// Called by the locks shared with the audio thread's data, e.g. the SnapshotBuffer writer lock
+    static void noteLockAcquired() noexcept;
+
+    Report getReport() const noexcept;
+
+    /// Returns true once for every batch of newly violating blocks, call from a non-realtime thread
+    bool hasNewViolations() noexcept;
+
+private:
+    std::atomic<juce::uint32> allocations { 0 };
+    std::atomic<juce::uint32> lockAcquisitions { 0 };
+    std::atomic<juce::uint32> violatingBlocks { 0 };
+    juce::uint32 lastReportedViolatingBlocks = 0;
+};
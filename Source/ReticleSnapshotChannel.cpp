@@ -0,0 +1,59 @@
+#include "ReticleSnapshotChannel.h"
+
+const std::vector<std::string>* ReticleSnapshotChannel::internNames(int inputMode, int outputMode, Mach1Encode<float>& encode)
+{
+    const auto key = std::make_pair(inputMode, outputMode);
+    auto found = internedNames.find(key);
+    if (found == internedNames.end())
+        found = internedNames.emplace(key, encode.getPointsNames()).first;
+
+    return &found->second;
+}
+
+void ReticleSnapshotChannel::publish(const std::vector<Mach1Point3D>& points, const std::vector<std::string>* newNames) noexcept
+{
+    const int count = juce::jmin((int)points.size(), (int)maxPoints);
+    const auto start = sequence.load(std::memory_order_relaxed);
+
+    sequence.store(start + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    for (int point = 0; point < count; point++)
+    {
+        coordinates[(size_t)point * 3].store(points[(size_t)point].x, std::memory_order_relaxed);
+        coordinates[(size_t)point * 3 + 1].store(points[(size_t)point].y, std::memory_order_relaxed);
+        coordinates[(size_t)point * 3 + 2].store(points[(size_t)point].z, std::memory_order_relaxed);
+    }
+    numPoints.store(count, std::memory_order_relaxed);
+    names.store(newNames, std::memory_order_relaxed);
+
+    sequence.store(start + 2, std::memory_order_release);
+}
+
+bool ReticleSnapshotChannel::read(View& view) const noexcept
+{
+    const auto start = sequence.load(std::memory_order_acquire);
+    if (start == view.generation || (start & 1u) != 0)
+        return false; // nothing new, or a publish is in progress and the view keeps the previous snapshot
+
+    // copied aside, a publish that overlaps the copy must not tear the view the caller draws
+    std::array<Mach1Point3D, maxPoints> copied;
+    const int count = numPoints.load(std::memory_order_relaxed);
+    for (int point = 0; point < count; point++)
+    {
+        copied[(size_t)point].x = coordinates[(size_t)point * 3].load(std::memory_order_relaxed);
+        copied[(size_t)point].y = coordinates[(size_t)point * 3 + 1].load(std::memory_order_relaxed);
+        copied[(size_t)point].z = coordinates[(size_t)point * 3 + 2].load(std::memory_order_relaxed);
+    }
+    const auto* currentNames = names.load(std::memory_order_relaxed);
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (sequence.load(std::memory_order_relaxed) != start)
+        return false;
+
+    std::copy(copied.begin(), copied.begin() + count, view.points.begin());
+    view.generation = start;
+    view.numPoints = count;
+    view.names = currentNames;
+    return true;
+}
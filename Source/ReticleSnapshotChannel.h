@@ -0,0 +1,67 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <Mach1Encode.h>
+
+#include <array>
+#include <atomic>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+/// Seqlock handoff of the reticle points from whichever editor thread refreshes them to every view that
+/// draws them.
+///
+/// Readers never block or retry: they keep their own `View` and `read()` only copies the points when
+/// the generation moved on. If a refresh overlaps the copy the view keeps the previous snapshot and
+/// the next read picks up the new one. Refreshes are serialised with a
+/// try-flag instead of a lock, a thread that finds another one refreshing simply reads what is there.
+/// Point names only depend on the i/o modes, they are interned once per mode pair and shared by pointer.
+class ReticleSnapshotChannel
+{
+public:
+    static constexpr int maxPoints = 64;
+
+    /// A reader's copy of the last snapshot it picked up
+    struct View
+    {
+        juce::uint32 generation = 0;
+        int numPoints = 0;
+        std::array<Mach1Point3D, maxPoints> points {};
+        const std::vector<std::string>* names = nullptr; // interned, valid for the lifetime of the channel
+
+        int getNumNames() const noexcept { return names != nullptr ? (int)names->size() : 0; }
+        const std::string& getName(int index) const { return (*names)[(size_t)index]; }
+    };
+
+    ReticleSnapshotChannel() = default;
+
+    /// Writer: returns false if another thread is refreshing right now, otherwise endWrite() must follow
+    bool tryBeginWrite() noexcept { return !writing.test_and_set(std::memory_order_acquire); }
+    void endWrite() noexcept { writing.clear(std::memory_order_release); }
+
+    /// Writer: the names for an i/o mode pair, `encode` is only asked for them the first time
+    const std::vector<std::string>* internNames(int inputMode, int outputMode, Mach1Encode<float>& encode);
+
+    /// Writer: publishes new points, at most `maxPoints` are kept
+    void publish(const std::vector<Mach1Point3D>& points, const std::vector<std::string>* names) noexcept;
+
+    /// Any thread, wait-free: updates `view` if a newer, completely published snapshot exists and
+    /// returns true if it did. Returns false without touching `view` while a publish is in progress.
+    bool read(View& view) const noexcept;
+
+    juce::uint32 getGeneration() const noexcept { return sequence.load(std::memory_order_acquire) & ~1u; }
+
+private:
+    std::atomic_flag writing = ATOMIC_FLAG_INIT;
+
+    // odd while a publish is in progress, the payload is relaxed atomics so readers may overlap a publish
+    std::atomic<juce::uint32> sequence { 0 };
+    std::atomic<int> numPoints { 0 };
+    std::atomic<const std::vector<std::string>*> names { nullptr };
+    std::array<std::atomic<float>, maxPoints * 3> coordinates {};
+
+    // only touched by the writer, std::map never moves its values so published pointers stay valid
+    std::map<std::pair<int, int>, std::vector<std::string>> internedNames;
+};
@@ -0,0 +1,193 @@
+#include "SharedMemoryRing.h"
+
+#if JUCE_LINUX
+    #include <climits>
+    #include <ctime>
+    #include <linux/futex.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#elif JUCE_MAC
+// the cross-process address wait libc++ builds std::atomic::wait on
+extern "C" int __ulock_wait(uint32_t operation, void* address, uint64_t value, uint32_t timeoutMicroseconds);
+extern "C" int __ulock_wake(uint32_t operation, void* address, uint64_t wakeValue);
+#endif
+
+namespace
+{
+constexpr size_t writePositionOffset = 64;
+constexpr size_t doorbellOffset = 68;
+constexpr size_t readPositionOffset = 128;
+constexpr size_t consumerWaitingOffset = 132;
+
+#if JUCE_LINUX
+// not FUTEX_PRIVATE_FLAG, the word is shared with another process
+void waitWhileEqual(std::atomic<juce::uint32>* word, juce::uint32 value, int timeoutMs) noexcept
+{
+    const timespec timeout { timeoutMs / 1000, (long)(timeoutMs % 1000) * 1000000L };
+    syscall(SYS_futex, reinterpret_cast<juce::uint32*>(word), FUTEX_WAIT, value, &timeout, nullptr, 0);
+}
+
+void wakeAll(std::atomic<juce::uint32>* word) noexcept
+{
+    syscall(SYS_futex, reinterpret_cast<juce::uint32*>(word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+}
+#elif JUCE_MAC
+constexpr uint32_t compareAndWaitShared = 3; // UL_COMPARE_AND_WAIT_SHARED
+constexpr uint32_t wakeAllWaiters = 0x100; // ULF_WAKE_ALL
+
+void waitWhileEqual(std::atomic<juce::uint32>* word, juce::uint32 value, int timeoutMs) noexcept
+{
+    __ulock_wait(compareAndWaitShared, word, value, (uint32_t)timeoutMs * 1000u);
+}
+
+void wakeAll(std::atomic<juce::uint32>* word) noexcept
+{
+    __ulock_wake(compareAndWaitShared | wakeAllWaiters, word, 0);
+}
+#else
+// no address wait across processes here, the consumer falls back to short sleeps
+void waitWhileEqual(std::atomic<juce::uint32>* word, juce::uint32 value, int timeoutMs) noexcept
+{
+    if (word->load(std::memory_order_acquire) == value)
+        juce::Thread::sleep(juce::jmin(timeoutMs, 1));
+}
+
+void wakeAll(std::atomic<juce::uint32>*) noexcept
+{
+}
+#endif
+
+juce::uint32* getHeader(void* memory) noexcept
+{
+    return static_cast<juce::uint32*>(memory);
+}
+}
+
+void SharedMemoryRing::initialise(void* memory, juce::uint32 capacity) noexcept
+{
+    jassert(juce::isPowerOfTwo(capacity));
+    auto* header = getHeader(memory);
+    header[1] = version;
+    header[2] = capacity;
+    header[3] = 0;
+    new (static_cast<char*>(memory) + writePositionOffset) std::atomic<juce::uint32>(0);
+    new (static_cast<char*>(memory) + readPositionOffset) std::atomic<juce::uint32>(0);
+    new (static_cast<char*>(memory) + doorbellOffset) std::atomic<juce::uint32>(0);
+    new (static_cast<char*>(memory) + consumerWaitingOffset) std::atomic<juce::uint32>(0);
+
+    // the magic goes in last, a peer that sees it sees a complete header
+    std::atomic_thread_fence(std::memory_order_release);
+    header[0] = magic;
+}
+
+SharedMemoryRing::SharedMemoryRing(void* memory, size_t size) noexcept
+{
+    if (memory == nullptr || size < headerSize)
+        return;
+
+    const auto* header = getHeader(memory);
+    const auto ringCapacity = header[2];
+    if (header[0] != magic || header[1] != version || !juce::isPowerOfTwo(ringCapacity) || getRequiredSize(ringCapacity) > size)
+        return;
+
+    writePosition = reinterpret_cast<std::atomic<juce::uint32>*>(static_cast<char*>(memory) + writePositionOffset);
+    readPosition = reinterpret_cast<std::atomic<juce::uint32>*>(static_cast<char*>(memory) + readPositionOffset);
+    doorbell = reinterpret_cast<std::atomic<juce::uint32>*>(static_cast<char*>(memory) + doorbellOffset);
+    consumerWaiting = reinterpret_cast<std::atomic<juce::uint32>*>(static_cast<char*>(memory) + consumerWaitingOffset);
+    data = static_cast<juce::uint8*>(memory) + headerSize;
+    capacity = ringCapacity;
+}
+
+bool SharedMemoryRing::write(const void* payload, juce::uint32 size) noexcept
+{
+    jassert(isValid());
+    const auto recordSize = (juce::uint32)sizeof(juce::uint32) + getPaddedSize(size);
+    if (recordSize > capacity / 2)
+        return false;
+
+    auto position = writePosition->load(std::memory_order_relaxed);
+    const auto freeSpace = capacity - (position - readPosition->load(std::memory_order_acquire));
+    const auto offset = position & (capacity - 1);
+    const auto tailSpace = capacity - offset;
+
+    // a record that would cross the end starts over at the front
+    const auto skip = recordSize > tailSpace ? tailSpace : 0u;
+    if (skip + recordSize > freeSpace)
+        return false;
+
+    if (skip > 0)
+    {
+        juce::writeUnaligned<juce::uint32>(data + offset, wrapMarker);
+        position += skip;
+    }
+
+    auto* record = data + (position & (capacity - 1));
+    juce::writeUnaligned<juce::uint32>(record, size);
+    memcpy(record + sizeof(juce::uint32), payload, size);
+
+    writePosition->store(position + recordSize, std::memory_order_release);
+
+    // orders the store above before the load of the flag, pairs with the fence in waitForData()
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (consumerWaiting->load(std::memory_order_relaxed) != 0)
+        wakeUp();
+    return true;
+}
+
+bool SharedMemoryRing::read(juce::MemoryBlock& destination)
+{
+    jassert(isValid());
+    auto position = readPosition->load(std::memory_order_relaxed);
+    const auto available = writePosition->load(std::memory_order_acquire);
+
+    if (position == available)
+        return false;
+
+    auto offset = position & (capacity - 1);
+    auto size = juce::readUnaligned<juce::uint32>(data + offset);
+    if (size == wrapMarker)
+    {
+        position += capacity - offset;
+        if (position == available)
+        {
+            readPosition->store(position, std::memory_order_release);
+            return false;
+        }
+        offset = 0;
+        size = juce::readUnaligned<juce::uint32>(data);
+    }
+
+    // a corrupt length means the peer is not speaking this protocol, drop everything it wrote
+    if (size > capacity - offset - sizeof(juce::uint32) || size > available - position)
+    {
+        readPosition->store(available, std::memory_order_release);
+        return false;
+    }
+
+    destination.replaceAll(data + offset + sizeof(juce::uint32), size);
+    readPosition->store(position + (juce::uint32)sizeof(juce::uint32) + getPaddedSize(size), std::memory_order_release);
+    return true;
+}
+
+
+void SharedMemoryRing::waitForData(int timeoutMs) noexcept
+{
+    jassert(isValid());
+    const auto ticket = doorbell->load(std::memory_order_acquire);
+    consumerWaiting->store(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    // a producer that wrote before the flag was visible is seen here, one that wrote after it sees
+    // the flag and moves the doorbell off `ticket`, so the wait returns at once
+    if (readPosition->load(std::memory_order_relaxed) == writePosition->load(std::memory_order_acquire))
+        waitWhileEqual(doorbell, ticket, timeoutMs);
+
+    consumerWaiting->store(0, std::memory_order_relaxed);
+}
+
+void SharedMemoryRing::wakeUp() noexcept
+{
+    jassert(isValid());
+    doorbell->fetch_add(1, std::memory_order_release);
+    wakeAll(doorbell);
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+#include <atomic>
+
+/// Lock-free single producer / single consumer byte ring laid out in memory that two processes map.
+///
+/// Layout, all integers in host byte order:
+///   0    header: magic, version, capacity (a power of two), reserved
+///   64   write position, advanced by the producer only
+///   68   doorbell, bumped by the producer to wake a sleeping consumer
+///   128  read position, advanced by the consumer only
+///   132  consumer waiting flag, 1 while the consumer sleeps on the doorbell
+///   192  `capacity` bytes of records
+///
+/// Positions are free running 32 bit byte counters. A record is a 32 bit payload length followed by
+/// the payload padded to 4 bytes and never wraps, the producer fills the tail with a `wrapMarker`
+/// length instead. Each side's words live on their own cache line so the two sides don't share one.
+///
+/// An empty ring doesn't have to be polled: the consumer raises its waiting flag and sleeps on the
+/// doorbell word (a futex on Linux, `__ulock_wait` on macOS), and a producer that sees the flag
+/// after writing bumps the doorbell and wakes it. While the consumer keeps up no side makes a syscall.
+/// Where no cross-process address wait exists the consumer sleeps a millisecond at a time instead.
+class SharedMemoryRing
+{
+public:
+    static constexpr juce::uint32 magic = 0x4d315242; // "M1RB"
+    static constexpr juce::uint32 version = 2;
+    static constexpr size_t headerSize = 192;
+    static constexpr juce::uint32 wrapMarker = 0xffffffff;
+
+    /// Bytes of memory a ring with `capacity` bytes of records needs
+    static size_t getRequiredSize(juce::uint32 capacity) noexcept { return headerSize + capacity; }
+
+    /// Writes an empty ring header into zeroed `memory`
+    static void initialise(void* memory, juce::uint32 capacity) noexcept;
+
+    /// Attaches to memory that holds an initialised ring of `size` bytes
+    SharedMemoryRing(void* memory, size_t size) noexcept;
+
+    /// False if the memory does not hold a ring of this version that fits its size
+    bool isValid() const noexcept { return data != nullptr; }
+
+    /// Producer side: appends one record and wakes a waiting consumer, false if it does not fit into
+    /// the free space right now
+    bool write(const void* payload, juce::uint32 size) noexcept;
+
+    /// Consumer side: copies the next record into `destination`, false if the ring is empty
+    bool read(juce::MemoryBlock& destination);
+
+    /// Consumer side: returns once the ring may hold a record, after a wakeUp(), or after `timeoutMs`
+    void waitForData(int timeoutMs) noexcept;
+
+    /// Rings the doorbell, a consumer in waitForData() returns
+    void wakeUp() noexcept;
+
+private:
+    static juce::uint32 getPaddedSize(juce::uint32 size) noexcept { return (size + 3u) & ~3u; }
+
+    std::atomic<juce::uint32>* writePosition = nullptr;
+    std::atomic<juce::uint32>* readPosition = nullptr;
+    std::atomic<juce::uint32>* doorbell = nullptr;
+    std::atomic<juce::uint32>* consumerWaiting = nullptr;
+    juce::uint8* data = nullptr;
+    juce::uint32 capacity = 0;
+
+    static_assert(std::atomic<juce::uint32>::is_always_lock_free && sizeof(std::atomic<juce::uint32>) == sizeof(juce::uint32),
+                  "the ring positions and the doorbell are shared with another process and must be plain lock-free words");
+};
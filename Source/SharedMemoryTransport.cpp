@@ -0,0 +1,257 @@
+#include "SharedMemoryTransport.h"
+
+#if !JUCE_WINDOWS
+    #include <fcntl.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace
+{
+juce::File getTransportDirectory()
+{
+    // tmpfs on Linux keeps the rings out of the page cache writeback
+    const juce::File shm("/dev/shm");
+    if (shm.isDirectory() && shm.hasWriteAccess())
+        return shm;
+    return juce::File::getSpecialLocation(juce::File::tempDirectory);
+}
+
+/// Creates a zeroed ring file, fails if anything already exists at its path
+bool createRingFile(const juce::File& file)
+{
+    const auto size = SharedMemoryRing::getRequiredSize(SharedMemoryTransport::ringCapacity);
+#if JUCE_WINDOWS
+    if (file.exists())
+        return false;
+
+    juce::FileOutputStream stream(file);
+    if (stream.failedToOpen())
+        return false;
+
+    juce::HeapBlock<char> zeros(size, true);
+    if (!stream.write(zeros.get(), size))
+        return false;
+
+    stream.flush();
+    return stream.getStatus().wasOk();
+#else
+    // a new file only this user can open, never one or a link somebody else placed at the name
+    const int fd = open(file.getFullPathName().toRawUTF8(), O_CREAT | O_EXCL | O_NOFOLLOW | O_RDWR | O_CLOEXEC, S_IRUSR | S_IWUSR);
+    if (fd < 0)
+        return false;
+
+    const bool sized = ftruncate(fd, (off_t)size) == 0;
+    close(fd);
+    return sized;
+#endif
+}
+
+void writePaddedString(juce::MemoryOutputStream& stream, const juce::String& text)
+{
+    const auto utf8 = text.toRawUTF8();
+    const auto length = strlen(utf8);
+    stream.write(utf8, length);
+    stream.writeRepeatedByte(0, 4 - (length % 4));
+}
+
+bool readPaddedString(juce::MemoryInputStream& stream, juce::String& text)
+{
+    const auto* start = static_cast<const char*>(stream.getData()) + stream.getPosition();
+    const auto remaining = (size_t)stream.getNumBytesRemaining();
+    const auto length = strnlen(start, remaining);
+    if (length == remaining)
+        return false;
+
+    text = juce::String::fromUTF8(start, (int)length);
+    stream.skipNextBytes((juce::int64)(length + 4 - (length % 4)));
+    return true;
+}
+}
+
+std::unique_ptr<SharedMemoryTransport> SharedMemoryTransport::create(int port, std::function<void()> onMessagesAvailable)
+{
+    // the random part keeps other processes from guessing the names, the helper gets them with the offer
+    const auto directory = getTransportDirectory();
+    const auto name = "m1-panner-" + juce::String(port) + "-" + juce::String::toHexString(juce::Random::getSystemRandom().nextInt64());
+
+    std::unique_ptr<SharedMemoryTransport> transport(new SharedMemoryTransport(directory.getChildFile(name + "-out"),
+                                                                               directory.getChildFile(name + "-in"),
+                                                                               std::move(onMessagesAvailable)));
+    if (!transport->open())
+        return nullptr;
+
+    transport->startThread();
+    return transport;
+}
+
+SharedMemoryTransport::SharedMemoryTransport(const juce::File& outboundFile_, const juce::File& inboundFile_, std::function<void()> onMessagesAvailable_)
+    : juce::Thread("M1 Helper Transport"), outboundFile(outboundFile_), inboundFile(inboundFile_), onMessagesAvailable(std::move(onMessagesAvailable_))
+{
+}
+
+SharedMemoryTransport::~SharedMemoryTransport()
+{
+    signalThreadShouldExit();
+    if (inbound != nullptr)
+        inbound->wakeUp();
+    stopThread(100);
+    outbound.reset();
+    inbound.reset();
+    outboundMapping.reset();
+    inboundMapping.reset();
+    outboundFile.deleteFile();
+    inboundFile.deleteFile();
+}
+
+bool SharedMemoryTransport::open()
+{
+    // a path that already existed is not ours to delete when this fails
+    if (!createRingFile(outboundFile))
+    {
+        outboundFile = inboundFile = juce::File();
+        return false;
+    }
+    if (!createRingFile(inboundFile))
+    {
+        inboundFile = juce::File();
+        return false;
+    }
+
+    outboundMapping = std::make_unique<juce::MemoryMappedFile>(outboundFile, juce::MemoryMappedFile::readWrite);
+    inboundMapping = std::make_unique<juce::MemoryMappedFile>(inboundFile, juce::MemoryMappedFile::readWrite);
+    if (outboundMapping->getData() == nullptr || inboundMapping->getData() == nullptr)
+        return false;
+
+    SharedMemoryRing::initialise(outboundMapping->getData(), ringCapacity);
+    SharedMemoryRing::initialise(inboundMapping->getData(), ringCapacity);
+    outbound = std::make_unique<SharedMemoryRing>(outboundMapping->getData(), outboundMapping->getSize());
+    inbound = std::make_unique<SharedMemoryRing>(inboundMapping->getData(), inboundMapping->getSize());
+    return outbound->isValid() && inbound->isValid();
+}
+
+bool SharedMemoryTransport::send(const juce::OSCMessage& msg)
+{
+    encodeBuffer.reset();
+    if (!encode(msg, encodeBuffer))
+        return false;
+
+    return outbound->write(encodeBuffer.getData(), (juce::uint32)encodeBuffer.getDataSize());
+}
+
+std::vector<juce::OSCMessage> SharedMemoryTransport::takeReceivedMessages()
+{
+    std::vector<juce::OSCMessage> messages;
+    const juce::ScopedLock sl(receivedLock);
+    messages.swap(received);
+    return messages;
+}
+
+void SharedMemoryTransport::run()
+{
+    juce::MemoryBlock record;
+
+    while (!threadShouldExit())
+    {
+        bool receivedAny = false;
+        while (inbound->read(record))
+        {
+            if (auto msg = decode(record.getData(), record.getSize()))
+            {
+                const juce::ScopedLock sl(receivedLock);
+                received.push_back(std::move(*msg));
+                receivedAny = true;
+            }
+        }
+
+        if (receivedAny && onMessagesAvailable != nullptr)
+            onMessagesAvailable();
+
+        // returns as soon as the helper writes, no spinning and no timed polls
+        inbound->waitForData(maxWaitMs);
+    }
+}
+
+bool SharedMemoryTransport::encode(const juce::OSCMessage& msg, juce::MemoryOutputStream& stream)
+{
+    juce::String typeTags(",");
+    for (const auto& argument : msg)
+        typeTags += juce::String::charToString((juce::juce_wchar)argument.getType());
+
+    writePaddedString(stream, msg.getAddressPattern().toString());
+    writePaddedString(stream, typeTags);
+
+    // OSC arguments are big endian
+    for (const auto& argument : msg)
+    {
+        if (argument.isInt32())
+            stream.writeIntBigEndian(argument.getInt32());
+        else if (argument.isFloat32())
+            stream.writeFloatBigEndian(argument.getFloat32());
+        else if (argument.isString())
+            writePaddedString(stream, argument.getString());
+        else if (argument.isColour())
+            stream.writeIntBigEndian((int)argument.getColour().toInt32());
+        else if (argument.isBlob())
+        {
+            const auto& blob = argument.getBlob();
+            stream.writeIntBigEndian((int)blob.getSize());
+            stream.write(blob.getData(), blob.getSize());
+            stream.writeRepeatedByte(0, (4 - (blob.getSize() % 4)) % 4);
+        }
+        else
+            return false;
+    }
+    return true;
+}
+
+std::optional<juce::OSCMessage> SharedMemoryTransport::decode(const void* data, size_t size)
+{
+    juce::MemoryInputStream stream(data, size, false);
+    juce::String address, typeTags;
+    if (!readPaddedString(stream, address) || !readPaddedString(stream, typeTags) || !typeTags.startsWithChar(','))
+        return std::nullopt;
+
+    try
+    {
+        juce::OSCMessage msg = juce::OSCMessage(juce::OSCAddressPattern(address));
+        for (int i = 1; i < typeTags.length(); i++)
+        {
+            const auto type = (char)typeTags[i];
+            const auto needed = type == juce::OSCTypes::string ? 1 : 4;
+            if (stream.getNumBytesRemaining() < needed)
+                return std::nullopt;
+
+            if (type == juce::OSCTypes::int32)
+                msg.addInt32(stream.readIntBigEndian());
+            else if (type == juce::OSCTypes::float32)
+                msg.addFloat32(stream.readFloatBigEndian());
+            else if (type == juce::OSCTypes::colour)
+                msg.addColour(juce::OSCColour::fromInt32((juce::uint32)stream.readIntBigEndian()));
+            else if (type == juce::OSCTypes::string)
+            {
+                juce::String text;
+                if (!readPaddedString(stream, text))
+                    return std::nullopt;
+                msg.addString(text);
+            }
+            else if (type == juce::OSCTypes::blob)
+            {
+                const auto blobSize = stream.readIntBigEndian();
+                if (blobSize < 0 || blobSize > stream.getNumBytesRemaining())
+                    return std::nullopt;
+                juce::MemoryBlock blob;
+                stream.readIntoMemoryBlock(blob, blobSize);
+                stream.skipNextBytes((4 - (blobSize % 4)) % 4);
+                msg.addBlob(std::move(blob));
+            }
+            else
+                return std::nullopt;
+        }
+        return msg;
+    }
+    catch (const juce::OSCFormatError&)
+    {
+        return std::nullopt;
+    }
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "SharedMemoryRing.h"
+
+/// A local alternative to the loopback UDP link between the panners of a process and the helper.
+///
+/// Two memory mapped files, each holding a SharedMemoryRing, carry OSC messages in their regular
+/// binary encoding: one from the panners to the helper and one back. The panner side creates them
+/// under a name made of the hub's receiver port and a random suffix, exclusively and readable by the
+/// current user only, and passes the paths with the offer. Sending is a copy into the ring, a
+/// background thread sleeps on the inbound ring's doorbell and hands what arrived to
+/// `onMessagesAvailable`. Neither side polls: the helper rings the doorbell after writing and
+/// `send()` rings the helper's when it sleeps. `maxWaitMs` only bounds a wait whose wakeup went missing.
+class SharedMemoryTransport : private juce::Thread
+{
+public:
+    static constexpr juce::uint32 ringCapacity = 1 << 18;
+    static constexpr int version = (int)SharedMemoryRing::version;
+    static constexpr int maxWaitMs = 100;
+
+    /// Creates and maps new ring files for `port`, nullptr if that is not possible here.
+    /// `onMessagesAvailable` is called on the receiving thread whenever new messages can be taken.
+    static std::unique_ptr<SharedMemoryTransport> create(int port, std::function<void()> onMessagesAvailable);
+
+    ~SharedMemoryTransport() override;
+
+    /// The paths the helper maps, passed along with the offer
+    juce::String getOutboundPath() const { return outboundFile.getFullPathName(); }
+    juce::String getInboundPath() const { return inboundFile.getFullPathName(); }
+
+    /// Copies one message into the outbound ring, false if it is full or the message can't be encoded
+    bool send(const juce::OSCMessage& msg);
+
+    /// Takes every message that arrived since the last call
+    std::vector<juce::OSCMessage> takeReceivedMessages();
+
+    static bool encode(const juce::OSCMessage& msg, juce::MemoryOutputStream& stream);
+    static std::optional<juce::OSCMessage> decode(const void* data, size_t size);
+
+private:
+    SharedMemoryTransport(const juce::File& outboundFile, const juce::File& inboundFile, std::function<void()> onMessagesAvailable);
+
+    bool open();
+    void run() override;
+
+    juce::File outboundFile, inboundFile;
+    std::function<void()> onMessagesAvailable;
+    std::unique_ptr<juce::MemoryMappedFile> outboundMapping, inboundMapping;
+    std::unique_ptr<SharedMemoryRing> outbound, inbound;
+
+    juce::MemoryOutputStream encodeBuffer;
+    juce::CriticalSection receivedLock;
+    std::vector<juce::OSCMessage> received;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SharedMemoryTransport)
+};
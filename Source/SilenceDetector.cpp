@@ -0,0 +1,35 @@
+#include "SilenceDetector.h"
+
+void SilenceDetector::prepare(double sampleRate, double holdSeconds) noexcept
+{
+    holdSamples = (juce::int64)std::ceil(juce::jmax(0.0, holdSeconds) * sampleRate);
+    silentSamples = 0;
+    skipping.store(false, std::memory_order_relaxed);
+}
+
+bool SilenceDetector::process(const float* const* inputs, int numInputs, int numSamples) noexcept
+{
+    for (int input_channel = 0; input_channel < numInputs; input_channel++)
+    {
+        if (inputs[input_channel] == nullptr)
+            continue;
+
+        const auto range = juce::FloatVectorOperations::findMinAndMax(inputs[input_channel], numSamples);
+        if (juce::jmax(-range.getStart(), range.getEnd()) >= threshold)
+        {
+            silentSamples = 0;
+            return false;
+        }
+    }
+
+    // the hold only counts whole silent blocks
+    const bool held = silentSamples >= holdSamples;
+    silentSamples += numSamples;
+    return held;
+}
+
+void SilenceDetector::countBlock(bool skipped) noexcept
+{
+    skipping.store(skipped, std::memory_order_relaxed);
+    (skipped ? skippedBlocks : processedBlocks).fetch_add(1, std::memory_order_relaxed);
+}
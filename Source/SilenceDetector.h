@@ -0,0 +1,50 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+#include <atomic>
+
+/// Tracks whether the inputs of a block are silent and for how long.
+///
+/// A block counts as silent when the peak of every input channel is below the threshold. The detector
+/// only reports a block as skippable after the inputs have been silent for the hold time, so mixer
+/// and ITD tails are played out before the outputs are simply cleared.
+class SilenceDetector
+{
+public:
+    struct Stats
+    {
+        juce::uint64 processedBlocks = 0;
+        juce::uint64 skippedBlocks = 0;
+    };
+
+    static constexpr float defaultThresholdDb = -120.0f;
+    static constexpr double defaultHoldSeconds = 0.1;
+
+    /// Call from prepareToPlay(), restarts the hold
+    void prepare(double sampleRate, double holdSeconds = defaultHoldSeconds) noexcept;
+
+    void setThresholdDb(float newThresholdDb) noexcept { threshold = juce::Decibels::decibelsToGain(newThresholdDb, -200.0f); }
+
+    /// Audio thread: scans the inputs of the block, nullptr channels count as silent. Returns true once
+    /// the inputs have been silent for at least the hold time.
+    bool process(const float* const* inputs, int numInputs, int numSamples) noexcept;
+
+    /// Audio thread: counts the block as skipped (true) or processed (false)
+    void countBlock(bool skipped) noexcept;
+
+    /// True while the last block counted was skipped
+    bool isSkipping() const noexcept { return skipping.load(std::memory_order_relaxed); }
+
+    /// Safe to call from any thread
+    Stats getStats() const noexcept { return { processedBlocks.load(std::memory_order_relaxed), skippedBlocks.load(std::memory_order_relaxed) }; }
+
+private:
+    float threshold = juce::Decibels::decibelsToGain(defaultThresholdDb, -200.0f);
+    juce::int64 holdSamples = 0;
+    juce::int64 silentSamples = 0;
+
+    std::atomic<bool> skipping { false };
+    std::atomic<juce::uint64> processedBlocks { 0 };
+    std::atomic<juce::uint64> skippedBlocks { 0 };
+};
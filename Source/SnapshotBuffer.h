@@ -0,0 +1,91 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <type_traits>
+
+#include "RealtimeGuard.h"
+
+/// Double-buffered handoff of a small trivially copyable value from any number of writers to any
+/// number of readers.
+///
+/// Writers are serialised by a spin lock, copy the latest value, modify it and store it into the slot
+/// readers are not pointed at before flipping the version, so `update()` must not be called from the
+/// audio thread. Readers never take the lock, they copy the current slot and only retry in the rare
+/// case a flip happened meanwhile. The slots hold relaxed atomics so an overlapping copy is never
+/// undefined behaviour, only discarded.
+template <typename T>
+class SnapshotBuffer
+{
+public:
+    static_assert(std::is_trivially_copyable<T>::value, "snapshots are copied word by word");
+
+    SnapshotBuffer() { store(0, T {}); }
+
+    /// Any thread but the audio thread: calls `modify` with a copy of the latest value and publishes the result. The lock is
+    /// only held for the copy and `modify`, which therefore has to be cheap and must not block.
+    template <typename Modifier>
+    void update(Modifier&& modify) noexcept
+    {
+        const juce::SpinLock::ScopedLockType lock(writerLock);
+        RealtimeGuard::noteLockAcquired();
+
+        const auto current = version.load(std::memory_order_relaxed);
+        T value = load(current);
+        modify(value);
+
+        // readers that see any of the stores below also see every earlier version flip
+        std::atomic_thread_fence(std::memory_order_release);
+        store(current + 1, value);
+        version.store(current + 1, std::memory_order_release);
+    }
+
+    /// Any thread: the latest published value
+    T read() const noexcept
+    {
+        for (;;)
+        {
+            const auto current = version.load(std::memory_order_acquire);
+            const T value = load(current);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (version.load(std::memory_order_relaxed) == current)
+                return value;
+        }
+    }
+
+    /// Increments with every update, lets readers skip work when nothing changed
+    juce::uint32 getVersion() const noexcept { return version.load(std::memory_order_acquire); }
+
+private:
+    static constexpr size_t numWords = (sizeof(T) + sizeof(juce::uint32) - 1) / sizeof(juce::uint32);
+    using Slot = std::array<std::atomic<juce::uint32>, numWords>;
+
+    T load(juce::uint32 slotVersion) const noexcept
+    {
+        const auto& slot = slots[slotVersion & 1];
+        std::array<juce::uint32, numWords> words;
+        for (size_t word = 0; word < numWords; word++)
+            words[word] = slot[word].load(std::memory_order_relaxed);
+
+        T value;
+        std::memcpy(&value, words.data(), sizeof(T));
+        return value;
+    }
+
+    void store(juce::uint32 slotVersion, const T& value) noexcept
+    {
+        std::array<juce::uint32, numWords> words {};
+        std::memcpy(words.data(), &value, sizeof(T));
+
+        auto& slot = slots[slotVersion & 1];
+        for (size_t word = 0; word < numWords; word++)
+            slot[word].store(words[word], std::memory_order_relaxed);
+    }
+
+    std::array<Slot, 2> slots {};
+    std::atomic<juce::uint32> version { 0 };
+    juce::SpinLock writerLock;
+};
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+
+/// Wait-free single producer / single consumer handoff of a value type.
+///
+/// The producer fills `getWriteBuffer()` and calls `publish()`, the consumer calls `acquireLatest()`
+/// and then reads `getReadBuffer()`. Neither side ever blocks or allocates, the consumer always sees
+/// the most recently published complete value and intermediate values may be skipped.
+template <typename T>
+class TripleBuffer
+{
+public:
+    TripleBuffer() = default;
+
+    /// Producer side: the buffer that will be handed over on the next publish()
+    T& getWriteBuffer() noexcept { return buffers[(size_t)writeIndex]; }
+
+    /// Producer side: hands the write buffer over to the consumer
+    void publish() noexcept
+    {
+        const int previous = middle.exchange(writeIndex | freshFlag, std::memory_order_acq_rel);
+        writeIndex = previous & indexMask;
+    }
+
+    /// Consumer side: swaps in the latest published buffer, returns false if nothing new was published
+    bool acquireLatest() noexcept
+    {
+        if ((middle.load(std::memory_order_relaxed) & freshFlag) == 0)
+            return false;
+
+        const int previous = middle.exchange(readIndex, std::memory_order_acq_rel);
+        readIndex = previous & indexMask;
+        return true;
+    }
+
+    /// Consumer side: the buffer returned by the last successful acquireLatest()
+    const T& getReadBuffer() const noexcept { return buffers[(size_t)readIndex]; }
+
+private:
+    static constexpr int indexMask = 3;
+    static constexpr int freshFlag = 4;
+
+    std::array<T, 3> buffers {};
+    int writeIndex = 0;
+    int readIndex = 1;
+    std::atomic<int> middle { 2 };
+};
@@ -55,9 +55,9 @@ struct MixerSettings
 {
     int monitor_input_channel_count;
     int monitor_output_channel_count;
-    float yaw;
-    float pitch;
-    float roll;
+    float yaw = 0.0f;
+    float pitch = 0.0f;
+    float roll = 0.0f;
     int monitor_mode = 0; // set default for when no monitor is found
 
     bool yawActive, pitchActive, rollActive = true;
@@ -37,7 +37,7 @@ public:
         // v is the input volume normalised, 0 to 1
         float v = clamp(map(volume, -48, 6, 0, 1), 0, 1);
 
-        if (volume > 0)
+        if (volume > 0 || clipping)
         {
             clipIndicatorReachedTime = m.getElapsedTime();
             // red clip indicator
@@ -141,4 +141,10 @@ public:
         withVolume, // setter
         0.0 // default
     )
+    MURKA_PARAMETER(M1VolumeDisplayLine, // class name
+        bool, // parameter type
+        clipping, // parameter variable name
+        withClipping, // setter
+        false // default
+    )
 };
@@ -13,13 +13,14 @@ public:
     {
         bool isInside = inside() * hasMouseFocus(m);
         XYRZ* xyrz = (XYRZ*)dataToControl;
-        std::vector<Mach1Point3D> points;
-        std::vector<std::string> pointsNames;
 
+        // only copies when the processor published a newer snapshot since the last frame
         if (processor != nullptr)
         {
-            processor->getUiReticleSnapshot(points, pointsNames);
+            processor->getUiReticleSnapshot(reticleSnapshot);
         }
+        const auto& points = reticleSnapshot.points;
+        const size_t numPoints = (size_t)reticleSnapshot.numPoints;
 
         m.enableFill();
 
@@ -80,15 +81,15 @@ public:
         }
 
         // Draw additional reticles for each input channel
-        if (processor != nullptr && points.size() > 1)
+        if (processor != nullptr && numPoints > 1)
         { // do not draw additional points if only mono input
-            for (size_t i = 0; i < points.size() && i < pointsNames.size(); i++)
+            for (size_t i = 0; i < numPoints && i < (size_t)reticleSnapshot.getNumNames(); i++)
             {
                 float r, d;
                 float x = points[i].z;
                 float y = points[i].x;
 
-                if (pointsNames[i] == "LFE") {
+                if (reticleSnapshot.getName((int)i) == "LFE") {
                     continue;
                 }
 
@@ -104,7 +105,7 @@ public:
                     float rotation_degree = juce::radiansToDegrees(rotation_radian);
                     r = (rotation_degree / 360.) + 0.5; // normalize 0->1
                 }
-                drawAdditionalReticle(r * shape.size.x, (-points[i].y + 1.0) / 2 * shape.size.y, pointsNames[i], reticleHovered, m);
+                drawAdditionalReticle(r * shape.size.x, (-points[i].y + 1.0) / 2 * shape.size.y, reticleSnapshot.getName((int)i), reticleHovered, m);
             }
         }
 
@@ -172,7 +173,7 @@ public:
         return normalized_x;
     }
 
-    void drawAdditionalReticle(float x, float y, std::string label, bool reticleHovered, Murka& m)
+    void drawAdditionalReticle(float x, float y, const std::string& label, bool reticleHovered, Murka& m)
     {
         float realx = x;
         float realy = y;
@@ -263,6 +264,7 @@ public:
     float sRotate = 0, sSpread = 50;
     Mach1Encode<float>* m1Encode = nullptr;
     M1PannerAudioProcessor* processor = nullptr;
+    ReticleSnapshotChannel::View reticleSnapshot;
     PannerSettings* pannerState = nullptr;
     MixerSettings* monitorState = nullptr;
     bool isConnected = false;
@@ -12,7 +12,7 @@ OverlayUIBaseComponent::OverlayUIBaseComponent(M1PannerAudioProcessor* processor
 
     processor = processor_;
     pannerState = &processor->pannerSettings;
-    monitorState = &processor->monitorSettings;
+    monitorState = &monitorDisplayState;
 }
 
 struct Line2D
@@ -159,6 +159,8 @@ void OverlayUIBaseComponent::draw()
     // Storing mouse for the curorHide() and cursorShow() functions
     currentMousePosition = getLocalPoint(nullptr, Desktop::getMousePosition());
 
+    monitorDisplayState = processor->getMonitorDisplayState(MonitorOrientationFeed::now());
+
     m.setFontFromRawData(PLUGIN_FONT, BINARYDATA_FONT, BINARYDATA_FONT_SIZE, DEFAULT_FONT_SIZE);
     m.setColor(0, 0);
     m.clear();
@@ -171,6 +173,7 @@ void OverlayUIBaseComponent::draw()
 
     if (pannerState)
     {
+        processor->syncUiCoordinatesFromParameters();
         XYRZ xyrz = { pannerState->x, pannerState->y, pannerState->azimuth, pannerState->elevation };
         auto& overlayReticleField = m.prepare<OverlayReticleField>({ 0, 0, m.getSize().width(), m.getSize().height() }).controlling(&xyrz);
         overlayReticleField.cursorHide = cursorHide;
@@ -20,6 +20,7 @@ class OverlayUIBaseComponent : public JuceMurkaBaseComponent
     M1PannerAudioProcessor* processor = nullptr;
     PannerSettings* pannerState = nullptr;
     MixerSettings* monitorState = nullptr;
+    MixerSettings monitorDisplayState {}; // the monitor settings with the orientation smoothed for this frame
 
 public:
     //==============================================================================
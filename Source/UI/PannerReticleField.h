@@ -21,12 +21,14 @@ public:
 
         m1encodeUpdate();
 
-        std::vector<Mach1Point3D> points;
-        std::vector<std::string> pointsNames;
+        // only copies when the processor published a newer snapshot since the last frame
         if (processor != nullptr)
         {
-            processor->getUiReticleSnapshot(points, pointsNames);
+            processor->getUiReticleSnapshot(reticleSnapshot);
         }
+        const auto& points = reticleSnapshot.points;
+        const size_t numPoints = (size_t)reticleSnapshot.numPoints;
+        const size_t numPointNames = (size_t)reticleSnapshot.getNumNames();
 
         XYRD* xyrd = (XYRD*)dataToControl;
 
@@ -182,22 +184,22 @@ public:
             // Reticles
             if (processor != nullptr && pannerState->m1Encode.getInputChannelsCount() > 1)
             {
-                for (size_t i = 0; i < points.size() && i < pointsNames.size() && i < processor->channelMuteStates.size(); i++)
+                for (size_t i = 0; i < numPoints && i < numPointNames && i < processor->channelMuteStates.size(); i++)
                 {
                     MurkaPoint point((points[i].z + 1.0) * shape.size.x / 2, (-points[i].x + 1.0) * shape.size.y / 2);
                     clamp(point.x, 0, shape.size.x);
                     clamp(point.y, 0, shape.size.y);
                     if (pannerState->m1Encode.getInputMode() == Mach1EncodeInputMode::Stereo || pannerState->m1Encode.getInputMode() == Mach1EncodeInputMode::LCR)
                     {
-                        drawAdditionalReticle(point.x, point.y, pointsNames[i], reticleHovered, 1, processor->channelMuteStates[i], m);
+                        drawAdditionalReticle(point.x, point.y, reticleSnapshot.getName((int)i), reticleHovered, 1, processor->channelMuteStates[i], m);
                     }
                     else if (pannerState->m1Encode.getInputMode() == Mach1EncodeInputMode::AFormat)
                     {
-                        drawAdditionalReticle(point.x, point.y, pointsNames[i], reticleHovered, 2, processor->channelMuteStates[i], m);
+                        drawAdditionalReticle(point.x, point.y, reticleSnapshot.getName((int)i), reticleHovered, 2, processor->channelMuteStates[i], m);
                     }
                     else
                     {
-                        drawAdditionalReticle(point.x, point.y, pointsNames[i], reticleHovered, 1.5, processor->channelMuteStates[i], m);
+                        drawAdditionalReticle(point.x, point.y, reticleSnapshot.getName((int)i), reticleHovered, 1.5, processor->channelMuteStates[i], m);
                     }
                 }
             }
@@ -253,7 +255,7 @@ public:
             && mouseDownPressed(0)
             && isKeyHeld(murka::MurkaKey::MURKA_KEY_ALT && pannerState->m1Encode.getInputChannelsCount() > 1))
         {
-            for (size_t i = 0; i < points.size() && i < processor->channelMuteStates.size(); i++)
+            for (size_t i = 0; i < numPoints && i < processor->channelMuteStates.size(); i++)
             {
                 MurkaPoint point((points[i].z + 1.0) * shape.size.x / 2, (-points[i].x + 1.0) * shape.size.y / 2);
 
@@ -288,7 +290,7 @@ public:
             input = max;
     }
 
-    void drawAdditionalReticle(float x, float y, std::string label, bool reticleHovered, float reticleSizeMultiplier, bool is_muted, Murka& m)
+    void drawAdditionalReticle(float x, float y, const std::string& label, bool reticleHovered, float reticleSizeMultiplier, bool is_muted, Murka& m)
     {
         m.setFontFromRawData(PLUGIN_FONT, BINARYDATA_FONT, BINARYDATA_FONT_SIZE, (DEFAULT_FONT_SIZE + 2 * A(reticleHovered) + (2 * (pannerState->elevation / 90))));
 
@@ -373,6 +375,7 @@ public:
     juce::OSCColour track_color;
 
     M1PannerAudioProcessor* processor; // Add this member variable
+    ReticleSnapshotChannel::View reticleSnapshot;
 
     // The results type, you also need to define it even if it's nothing.
     typedef bool Results;
@@ -11,7 +11,7 @@ PannerUIBaseComponent::PannerUIBaseComponent(M1PannerAudioProcessor* processor_)
 
     processor = processor_;
     pannerState = &processor->pannerSettings;
-    monitorState = &processor->monitorSettings;
+    monitorState = &monitorDisplayState;
 
     // Set up alert dismiss callback
     murkaAlert.onDismiss = [this]() {
@@ -87,11 +87,14 @@ void PannerUIBaseComponent::draw()
     // Storing mouse for the curorHide() and cursorShow() functions
     currentMousePosition = getLocalPoint(nullptr, Desktop::getMousePosition());
 
+    monitorDisplayState = processor->getMonitorDisplayState(MonitorOrientationFeed::now());
+
     m.setFontFromRawData(PLUGIN_FONT, BINARYDATA_FONT, BINARYDATA_FONT_SIZE, DEFAULT_FONT_SIZE - 1);
     m.setColor(BACKGROUND_GREY);
     m.clear();
     m.setLineWidth(2);
 
+    processor->syncUiCoordinatesFromParameters();
     XYRD xyrd = { pannerState->x, pannerState->y, pannerState->azimuth, pannerState->diverge };
     auto& reticleField = m.prepare<PannerReticleField>(MurkaShape(25, 30, 400, 400));
     reticleField.controlling(&xyrd);
@@ -794,7 +797,8 @@ void PannerUIBaseComponent::draw()
             // get the index order from the host
             int output_channel_reordered = processor->output_channel_indices[channelIndex];
 
-            auto& volumeDisplayLine = m.prepare<M1VolumeDisplayLine>({ 555 + 15 * cursorX, 30 + cursorY * lineHeight, 10, lineHeight - 33 }).withVolume(processor->outputMeterValuedB[output_channel_reordered]).draw();
+            const auto meter = processor->outputMeters.getReading(output_channel_reordered);
+            auto& volumeDisplayLine = m.prepare<M1VolumeDisplayLine>({ 555 + 15 * cursorX, 30 + cursorY * lineHeight, 10, lineHeight - 33 }).withVolume(meter.rmsDb).withClipping(meter.clipping).draw();
             m.setColor(LABEL_TEXT_COLOR);
             auto font = m.getCurrentFont();
             double singleDigitOffset = 0;
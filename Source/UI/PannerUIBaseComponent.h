@@ -29,6 +29,7 @@ class PannerUIBaseComponent : public JuceMurkaBaseComponent
     M1PannerAudioProcessor* processor = nullptr;
     PannerSettings* pannerState = nullptr;
     MixerSettings* monitorState = nullptr;
+    MixerSettings monitorDisplayState {}; // the monitor settings with the orientation smoothed for this frame
 
 public:
     //==============================================================================